@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stack>
+#include <vector>
+
+namespace mull {
+
+/// \brief Collects a separate call tree snapshot and running time for each
+/// test of a group of tests run in one sandboxed process.
+///
+/// The callbacks injected into every function normally record calls into a
+/// single mapping (see DynamicCallTree). While a batch is running, entering
+/// the entry point of one of its tests switches the recording to the
+/// mapping of that test and leaving it switches back to a scratch mapping,
+/// which collects the calls made outside of the tests (framework code,
+/// fixtures) and is thrown away.
+///
+/// The mappings and timings live in memory shared with the forked child.
+class BaselineBatch {
+  size_t functionsCount;
+  int capacity;
+  /// capacity + 1 mappings, the last one is the scratch mapping
+  uint64_t *mappings;
+  /// Start and end of the entry point of each test, in microseconds
+  uint64_t *timings;
+
+  std::map<uint64_t, int> entryPoints;
+  int activeSlot;
+  size_t activeDepth;
+  bool running;
+
+  int scratchSlot() const { return capacity; }
+
+public:
+  BaselineBatch(size_t functionsCount, int capacity);
+  ~BaselineBatch();
+
+  int getCapacity() const { return capacity; }
+
+  /// Clears the previous batch. `entryPointsOfTests[N]` are the indices
+  /// (in the Driver's function list) of the entry points of the N-th test.
+  void begin(const std::vector<std::vector<uint64_t>> &entryPointsOfTests);
+  void end();
+  bool isRunning() const { return running; }
+
+  void enterFunction(uint64_t functionIndex, std::stack<uint64_t> &stack);
+  void leaveFunction(uint64_t functionIndex, std::stack<uint64_t> &stack);
+
+  uint64_t *mapping(int slot);
+
+  /// Whether the entry point of the test was entered and left normally
+  bool hasFinished(int slot) const;
+  uint64_t runningTimeMicroseconds(int slot) const;
+};
+
+}
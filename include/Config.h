@@ -6,10 +6,16 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 static int MullDefaultTimeoutMilliseconds = 3000;
 
+static int MullDefaultWorkers() {
+  unsigned int concurrency = std::thread::hardware_concurrency();
+  return concurrency == 0 ? 1 : concurrency;
+}
+
 // We need these forward declarations to make our config friends with the
 // mapping traits.
 namespace mull {
@@ -58,10 +64,29 @@ class Config {
   bool useCache;
   bool emitDebugInfo;
   bool diagnostics;
+  bool detectEquivalentMutants;
 
   int timeout;
   int maxDistance;
+  int workers;
+  int shardIndex;
+  int shardCount;
   std::string cacheDirectory;
+  std::string resumeDatabasePath;
+  std::string keepOutput;
+  std::string previousResultsPath;
+  std::string traceFilePath;
+  std::string progress;
+  int progressInterval;
+  int baselineBatchSize;
+  bool mutantSlots;
+  bool prelinkSymbols;
+  bool lazyBitcode;
+  int mutantCacheSize;
+  bool releaseIR;
+  std::string baselineCodegen;
+  std::string mutantCodegen;
+  bool compileOnDemand;
 
   friend llvm::yaml::MappingTraits<mull::Config>;
 public:
@@ -91,9 +116,28 @@ public:
     useCache(false),
     emitDebugInfo(false),
     diagnostics(false),
+    detectEquivalentMutants(false),
     timeout(MullDefaultTimeoutMilliseconds),
     maxDistance(128),
-    cacheDirectory("/tmp/mull_cache")
+    workers(MullDefaultWorkers()),
+    shardIndex(0),
+    shardCount(1),
+    cacheDirectory("/tmp/mull_cache"),
+    resumeDatabasePath(""),
+    keepOutput("all"),
+    previousResultsPath(""),
+    traceFilePath(""),
+    progress("none"),
+    progressInterval(10),
+    baselineBatchSize(1),
+    mutantSlots(false),
+    prelinkSymbols(true),
+    lazyBitcode(false),
+    mutantCacheSize(1024),
+    releaseIR(true),
+    baselineCodegen("default"),
+    mutantCodegen("default"),
+    compileOnDemand(false)
   {
   }
 
@@ -128,9 +172,28 @@ public:
     useCache(cache),
     emitDebugInfo(debugInfo),
     diagnostics(diagnostics),
+    detectEquivalentMutants(false),
     timeout(timeout),
     maxDistance(distance),
-    cacheDirectory(cacheDir)
+    workers(MullDefaultWorkers()),
+    shardIndex(0),
+    shardCount(1),
+    cacheDirectory(cacheDir),
+    resumeDatabasePath(""),
+    keepOutput("all"),
+    previousResultsPath(""),
+    traceFilePath(""),
+    progress("none"),
+    progressInterval(10),
+    baselineBatchSize(1),
+    mutantSlots(false),
+    prelinkSymbols(true),
+    lazyBitcode(false),
+    mutantCacheSize(1024),
+    releaseIR(true),
+    baselineCodegen("default"),
+    mutantCodegen("default"),
+    compileOnDemand(false)
   {
   }
 
@@ -242,14 +305,115 @@ public:
     return diagnostics;
   }
 
+  bool shouldDetectEquivalentMutants() const {
+    return detectEquivalentMutants;
+  }
+
   int getMaxDistance() const {
     return maxDistance;
   }
 
+  int getWorkers() const {
+    return workers;
+  }
+
+  /// The mutants are split between shardCount runs (see ShardPartition),
+  /// this run executes the ones of the shard shardIndex (zero based)
+  int getShardIndex() const {
+    return shardIndex;
+  }
+
+  int getShardCount() const {
+    return shardCount;
+  }
+
   std::string getCacheDirectory() const {
     return cacheDirectory;
   }
 
+  /// Results database of an interrupted run to continue,
+  /// empty when starting from scratch
+  const std::string &getResumeDatabasePath() const {
+    return resumeDatabasePath;
+  }
+
+  /// Which mutants the report keeps stdout/stderr for:
+  /// "all" or "killed" (failed, crashed, timed out or exited abnormally)
+  const std::string &getKeepOutput() const {
+    return keepOutput;
+  }
+
+  /// Results database of an earlier run whose verdicts can be reused
+  /// for the mutants that are not affected by the changes since then
+  const std::string &getPreviousResultsPath() const {
+    return previousResultsPath;
+  }
+
+  /// Where to write the Chrome trace of the run, empty if not tracing
+  const std::string &getTraceFilePath() const {
+    return traceFilePath;
+  }
+
+  /// "none", "text" or "json" (one JSON object per line)
+  const std::string &getProgress() const {
+    return progress;
+  }
+
+  /// How often the progress is printed, in seconds
+  int getProgressInterval() const {
+    return progressInterval;
+  }
+
+  /// How many original tests are run in one sandboxed process
+  int getBaselineBatchSize() const {
+    return baselineBatchSize;
+  }
+
+  /// Whether all the mutants of a function are compiled into one object and
+  /// selected by a slot instead of being linked one by one
+  bool useMutantSlots() const {
+    return mutantSlots;
+  }
+
+  /// Whether the symbols the object files need are looked up once, before
+  /// the tests run, instead of on each link
+  bool shouldPrelinkSymbols() const {
+    return prelinkSymbols;
+  }
+
+  /// Whether function bodies are read from the bitcode only when the tests
+  /// reach them
+  bool shouldLoadBitcodeLazily() const {
+    return lazyBitcode;
+  }
+
+  /// Megabytes of memory the compiled mutants may take, 0 means no limit
+  int getMutantCacheSize() const {
+    return mutantCacheSize;
+  }
+
+  /// Whether the function bodies are dropped once the mutation points are
+  /// found. They are kept anyway when the debug info is emitted.
+  bool shouldReleaseIR() const {
+    return releaseIR;
+  }
+
+  /// Codegen profile of the original modules, see CodegenProfile
+  const std::string &getBaselineCodegen() const {
+    return baselineCodegen;
+  }
+
+  /// Codegen profile of the mutants, see CodegenProfileSelector
+  const std::string &getMutantCodegen() const {
+    return mutantCodegen;
+  }
+
+  /// Whether a mutant is compiled alone and linked next to the original
+  /// module, which calls its functions through stubs, see FunctionStubs
+  bool shouldCompileOnDemand() const {
+    return compileOnDemand;
+  }
+
   void dump() const {
     Logger::debug() << "Config>\n"
     << "\t" << "bitcode_file_list: " << bitcodeFileList << '\n'
@@ -258,9 +422,27 @@ public:
     << "\t" << "project_name: " << getProjectName() << '\n'
     << "\t" << "test_framework: " << getTestFramework() << '\n'
     << "\t" << "distance: " << getMaxDistance() << '\n'
+    << "\t" << "workers: " << getWorkers() << '\n'
+    << "\t" << "shard: " << getShardIndex() << "/" << getShardCount() << '\n'
     << "\t" << "dry_run: " << isDryRun() << '\n'
     << "\t" << "fork: " << getFork() << '\n'
-    << "\t" << "emit_debug_info: " << shouldEmitDebugInfo() << '\n';
+    << "\t" << "emit_debug_info: " << shouldEmitDebugInfo() << '\n'
+    << "\t" << "detect_equivalent_mutants: " << shouldDetectEquivalentMutants() << '\n'
+    << "\t" << "resume: " << getResumeDatabasePath() << '\n'
+    << "\t" << "keep_output: " << getKeepOutput() << '\n'
+    << "\t" << "previous_results: " << getPreviousResultsPath() << '\n'
+    << "\t" << "trace_file: " << getTraceFilePath() << '\n'
+    << "\t" << "progress: " << getProgress()
+    << " every " << getProgressInterval() << "s" << '\n'
+    << "\t" << "baseline_batch_size: " << getBaselineBatchSize() << '\n'
+    << "\t" << "mutant_slots: " << useMutantSlots() << '\n'
+    << "\t" << "prelink_symbols: " << shouldPrelinkSymbols() << '\n'
+    << "\t" << "lazy_bitcode: " << shouldLoadBitcodeLazily() << '\n'
+    << "\t" << "mutant_cache_size: " << getMutantCacheSize() << '\n'
+    << "\t" << "release_ir: " << shouldReleaseIR() << '\n'
+    << "\t" << "baseline_codegen: " << getBaselineCodegen() << '\n'
+    << "\t" << "mutant_codegen: " << getMutantCodegen() << '\n'
+    << "\t" << "compile_on_demand: " << shouldCompileOnDemand() << '\n';
 
     if (mutationOperators.empty() == false) {
       Logger::debug() << "\t" << "mutation_operators: " << '\n';
@@ -333,6 +515,104 @@ public:
       }
     }
 
+    if (workers < 1) {
+      std::stringstream error;
+
+      error << "workers parameter must be at least 1, got: " << workers;
+
+      errors.push_back(error.str());
+    }
+
+    if (shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount) {
+      std::stringstream error;
+
+      error << "shard_index must be in range [0, shard_count), got: "
+      << shardIndex << " with shard_count: " << shardCount;
+
+      errors.push_back(error.str());
+    }
+
+    if (keepOutput != "all" && keepOutput != "killed") {
+      std::stringstream error;
+
+      error << "keep_output parameter must be either 'all' or 'killed', got: "
+      << keepOutput;
+
+      errors.push_back(error.str());
+    }
+
+    if (progress != "none" && progress != "text" && progress != "json") {
+      std::stringstream error;
+
+      error << "progress parameter must be 'none', 'text' or 'json', got: "
+      << progress;
+
+      errors.push_back(error.str());
+    }
+
+    if (progressInterval < 1) {
+      std::stringstream error;
+
+      error << "progress_interval must be at least 1 second, got: "
+      << progressInterval;
+
+      errors.push_back(error.str());
+    }
+
+    if (baselineBatchSize < 1) {
+      std::stringstream error;
+
+      error << "baseline_batch_size must be at least 1, got: "
+      << baselineBatchSize;
+
+      errors.push_back(error.str());
+    }
+
+    if (mutantCacheSize < 0) {
+      std::stringstream error;
+
+      error << "mutant_cache_size must not be negative, got: "
+      << mutantCacheSize;
+
+      errors.push_back(error.str());
+    }
+
+    if (baselineCodegen != "fast" && baselineCodegen != "default" &&
+        baselineCodegen != "optimized") {
+      std::stringstream error;
+
+      error << "baseline_codegen parameter must be 'fast', 'default' or "
+      << "'optimized', got: " << baselineCodegen;
+
+      errors.push_back(error.str());
+    }
+
+    if (mutantCodegen != "fast" && mutantCodegen != "default" &&
+        mutantCodegen != "optimized" && mutantCodegen != "auto") {
+      std::stringstream error;
+
+      error << "mutant_codegen parameter must be 'fast', 'default', "
+      << "'optimized' or 'auto', got: " << mutantCodegen;
+
+      errors.push_back(error.str());
+    }
+
+    if (lazyBitcode && testFramework == "Rust") {
+      std::stringstream error;
+
+      error << "lazy_bitcode is not supported by the Rust test framework";
+
+      errors.push_back(error.str());
+    }
+
+    if (compileOnDemand && testFramework == "Rust") {
+      std::stringstream error;
+
+      error << "compile_on_demand is not supported by the Rust test framework";
+
+      errors.push_back(error.str());
+    }
+
     return errors;
   }
 
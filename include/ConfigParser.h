@@ -54,9 +54,28 @@ struct MappingTraits<mull::Config>
     io.mapOptional("use_cache", config.useCache);
     io.mapOptional("emit_debug_info", config.emitDebugInfo);
     io.mapOptional("diagnostics", config.diagnostics);
+    io.mapOptional("detect_equivalent_mutants", config.detectEquivalentMutants);
     io.mapOptional("timeout", config.timeout);
     io.mapOptional("max_distance", config.maxDistance);
+    io.mapOptional("workers", config.workers);
+    io.mapOptional("shard_index", config.shardIndex);
+    io.mapOptional("shard_count", config.shardCount);
     io.mapOptional("cache_directory", config.cacheDirectory);
+    io.mapOptional("resume", config.resumeDatabasePath);
+    io.mapOptional("keep_output", config.keepOutput);
+    io.mapOptional("previous_results", config.previousResultsPath);
+    io.mapOptional("trace_file", config.traceFilePath);
+    io.mapOptional("progress", config.progress);
+    io.mapOptional("progress_interval", config.progressInterval);
+    io.mapOptional("baseline_batch_size", config.baselineBatchSize);
+    io.mapOptional("mutant_slots", config.mutantSlots);
+    io.mapOptional("prelink_symbols", config.prelinkSymbols);
+    io.mapOptional("lazy_bitcode", config.lazyBitcode);
+    io.mapOptional("mutant_cache_size", config.mutantCacheSize);
+    io.mapOptional("release_ir", config.releaseIR);
+    io.mapOptional("baseline_codegen", config.baselineCodegen);
+    io.mapOptional("mutant_codegen", config.mutantCodegen);
+    io.mapOptional("compile_on_demand", config.compileOnDemand);
   }
 };
 }
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "BaselineBatch.h"
 #include "Config.h"
 #include "TestResult.h"
 #include "ForkProcessSandbox.h"
+#include "FunctionStubs.h"
 #include "IDEDiagnostics.h"
+#include "MutantSlots.h"
 #include "Context.h"
 #include "MutationOperators/MutationOperator.h"
 #include "DynamicCallTree.h"
@@ -27,6 +30,7 @@ class Config;
 class Filter;
 class ModuleLoader;
 class Result;
+class ResultSink;
 class TestFinder;
 class TestRunner;
 class MutationsFinder;
@@ -37,6 +41,13 @@ extern "C" void mull_enterFunction(Driver *driver, uint64_t functionIndex);
 extern "C" void mull_leaveFunction(Driver *driver, uint64_t functionIndex);
 
 class Driver {
+  /// Result of a test run without mutations along with the functions
+  /// the test reaches (testees)
+  struct BaselineRun {
+    std::unique_ptr<TestResult> result;
+    std::vector<std::unique_ptr<Testee>> testees;
+  };
+
   Config &Cfg;
   ModuleLoader &Loader;
   TestFinder &Finder;
@@ -47,17 +58,23 @@ class Driver {
   Context Ctx;
   ProcessSandbox *Sandbox;
   IDEDiagnostics *diagnostics;
+  ResultSink *sink;
   std::vector<CallTreeFunction> functions;
   DynamicCallTree dynamicCallTree;
   uint64_t *_callTreeMapping;
   std::stack<uint64_t> _callstack;
+  std::unique_ptr<BaselineBatch> _baselineBatch;
+  std::map<llvm::Function *, uint64_t> functionIndices;
+  MutantSlots mutantSlots;
+  FunctionStubs functionStubs;
 
   std::map<llvm::Module *, llvm::object::ObjectFile *> InnerCache;
   std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> precompiledObjectFiles;
+  CodegenProfileSelector mutantCodegen;
 
 public:
   Driver(Config &C, ModuleLoader &ML, TestFinder &TF, TestRunner &TR, Toolchain &t, Filter &f, MutationsFinder &mutationsFinder)
-    : Cfg(C), Loader(ML), Finder(TF), Runner(TR), toolchain(t), filter(f), mutationsFinder(mutationsFinder), dynamicCallTree(functions), _callTreeMapping(nullptr), precompiledObjectFiles() {
+    : Cfg(C), Loader(ML), Finder(TF), Runner(TR), toolchain(t), filter(f), mutationsFinder(mutationsFinder), sink(nullptr), dynamicCallTree(functions), _callTreeMapping(nullptr), precompiledObjectFiles(), mutantCodegen(C.getMutantCodegen()) {
 
       CallTreeFunction phonyRoot(nullptr);
       functions.push_back(phonyRoot);
@@ -78,17 +95,53 @@ public:
   ~Driver();
 
   std::unique_ptr<Result> Run();
+
+  /// Results are handed to the sink as soon as they are produced.
+  /// Mutation results are not kept in the Result returned by Run then.
+  void setResultSink(ResultSink *resultSink) {
+    sink = resultSink;
+  }
+
   uint64_t *callTreeMapping() {
     return _callTreeMapping;
   }
   std::stack<uint64_t> &callstack() {
     return _callstack;
   }
+  BaselineBatch *baselineBatch() {
+    return _baselineBatch.get();
+  }
 
 private:
   void prepareForExecution();
+
+  /// Runs the test in its own process and collects its testees
+  void runBaseline(std::unique_ptr<Test> test,
+                   std::vector<BaselineRun> &baselineRuns);
+  /// Runs the tests in a single process. Returns false, leaving the tests
+  /// untouched, if any of them did not pass.
+  bool runBaselineBatch(std::vector<std::unique_ptr<Test>> &tests,
+                        std::vector<BaselineRun> &baselineRuns);
+  void addBaselineRun(std::unique_ptr<Test> test,
+                      ExecutionResult &result,
+                      uint64_t *mapping,
+                      std::vector<BaselineRun> &baselineRuns);
+
   void injectCallbacks(llvm::Function *function, uint64_t index);
 
+  /// The mutants of the function compiled into one object, the mutant in
+  /// slot N is mutationPoints[N - 1]. Comes from the mutant cache when the
+  /// same mutants were compiled before.
+  llvm::object::ObjectFile *
+    dispatchObject(llvm::Function *function,
+                   const std::vector<MutationPoint *> &mutationPoints,
+                   long long testTime);
+
+  /// Compiles a module with mutants with the profile picked by
+  /// mutantCodegen, and records how long that took
+  llvm::object::OwningBinary<llvm::object::ObjectFile>
+    compileMutants(MullModule &module, CodegenProfile profile);
+
   /// Returns cached object files for all modules excerpt one provided
   std::vector<llvm::object::ObjectFile *> AllButOne(llvm::Module *One);
 
@@ -34,6 +34,8 @@ namespace mull {
 
     void prepare(uint64_t *m);
     std::unique_ptr<CallTree> createCallTree();
+    /// Same as above, but from a mapping other than the prepared one
+    std::unique_ptr<CallTree> createCallTree(uint64_t *mapping);
     void cleanupCallTree(std::unique_ptr<CallTree> root);
     std::vector<CallTree *> extractTestSubtrees(CallTree *root, Test *test);
     std::vector<std::unique_ptr<Testee>> createTestees(std::vector<CallTree *> subtrees,
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+
+}
+
+namespace mull {
+
+class Context;
+
+/// \brief Computes hashes of functions' IR that are stable across runs.
+///
+/// The hash of a function covers its own instructions, the initializers of
+/// the globals it refers to and, transitively, the hashes of the functions
+/// it calls or takes the address of, up to maxDistance calls away.
+/// Debug info is not hashed: moving a function around in its file does not
+/// change its hash, changing the function or anything it calls does.
+class FunctionHasher {
+  llvm::DenseMap<llvm::Function *, std::string> hashes;
+
+  void combineHashes(
+    const llvm::DenseMap<llvm::Function *, std::string> &bodies,
+    const llvm::DenseMap<llvm::Function *, std::vector<llvm::Function *>> &callees,
+    int maxDistance);
+
+public:
+  void computeHashes(Context &context, int maxDistance);
+
+  /// Hashes only the roots and the functions within maxDistance calls of
+  /// them, reading the bodies of lazily loaded functions on the way.
+  /// The hashes of the roots are the same as the ones computed for all the
+  /// functions.
+  void computeHashes(Context &context, int maxDistance,
+                     const std::vector<llvm::Function *> &roots);
+
+  /// Returns an empty string for functions without a body
+  std::string hashOf(llvm::Function *function) const;
+
+  static std::string hashFunctionBody(llvm::Function &function);
+};
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+
+namespace llvm {
+
+class Function;
+class Module;
+
+}
+
+namespace mull {
+
+class MullModule;
+
+/// \brief Stubs that let a mutant be compiled alone instead of with a whole
+/// copy of its module.
+///
+/// In the instrumented module every stubbed function F calls through the
+/// slot F.mull_slot: the original body when the slot is empty, the function
+/// it points to otherwise. The module leaves the slot undefined, the symbol
+/// cache resolves it to an empty slot.
+///
+/// A mutant object holds only the mutated body and defines the slot, pointing
+/// it to the mutant. The rest of the module is declared and resolved against
+/// the instrumented object, which is compiled once and linked as is. Only the
+/// mutated function is code-generated for each mutant.
+///
+/// Local symbols cannot be referenced from another object, so both sides
+/// give them the same external names first.
+class FunctionStubs {
+  /// The slot of every function without a mutant linked in
+  uint64_t emptySlot;
+  std::set<llvm::Function *> stubbedFunctions;
+
+public:
+  FunctionStubs() : emptySlot(0) {}
+
+  /// Whether calls to the function can go through a stub. Functions that
+  /// other modules may define as well are left alone.
+  static bool canStub(llvm::Function &function);
+
+  /// Gives the local symbols of the module external names that are unique
+  /// to the module
+  static void exposeLocalSymbols(llvm::Module &module, uint64_t moduleHash);
+
+  /// Turns the function of the instrumented module into a stub. The original
+  /// is the same function in the modules of the context.
+  void addStub(llvm::Function *original, llvm::Function *function);
+
+  bool hasStub(llvm::Function *original) const;
+
+  /// Reduces the mutated clone of the module to the mutant of the function
+  /// and declarations of everything else
+  static void extractMutant(MullModule &clone,
+                            llvm::Function *function,
+                            uint64_t moduleHash);
+};
+
+}
@@ -2,17 +2,41 @@
 
 #include "TestFinder.h"
 
+#include <map>
+#include <string>
 #include <vector>
 
+namespace llvm {
+class Function;
+class Module;
+}
+
 namespace mull {
 
 class Context;
 class Filter;
 
 class GoogleTestFinder : public TestFinder {
+  unsigned workers;
+
 public:
+  GoogleTestFinder(unsigned workers = 1);
+
+  /// Modules are scanned independently on a pool of `workers` threads,
+  /// the tests are returned in the order of the modules
   std::vector<std::unique_ptr<Test>> findTests(Context &context,
                                                Filter &filter) override;
+
+  /// Maps the class name of each test, e.g. `Hello_world_Test`,
+  /// to its TestBody function
+  static std::map<std::string, llvm::Function *>
+    indexTestBodies(llvm::Module &module);
+
+private:
+  std::vector<std::unique_ptr<Test>>
+    findTestsInModule(llvm::Module &module,
+                      Filter &filter,
+                      const std::vector<llvm::Function *> &constructors);
 };
 
 }
@@ -22,6 +22,7 @@ namespace mull {
 
 class GoogleTestRunner : public TestRunner {
   llvm::orc::ObjectLinkingLayer<> ObjectLayer;
+  llvm::orc::ObjectLinkingLayer<>::ObjSetHandleT linkedObjects;
   mull::Mangler mangler;
   llvm::orc::LocalCXXRuntimeOverrides overrides;
 
@@ -34,6 +35,16 @@ public:
   GoogleTestRunner(llvm::TargetMachine &machine);
   ExecutionStatus runTest(Test *test, ObjectFiles &objectFiles) override;
 
+  /// Runs the tests with a single --gtest_filter listing all of them
+  bool supportsBatching() override { return true; }
+  ExecutionStatus runTests(std::vector<Test *> &tests,
+                           ObjectFiles &objectFiles) override;
+
+  bool supportsLinkingAhead() override { return true; }
+  void linkObjectFiles(ObjectFiles &objectFiles) override;
+  ExecutionStatus runLinkedTests(std::vector<Test *> &tests) override;
+  void unlinkObjectFiles() override;
+
 private:
   void *GetCtorPointer(const llvm::Function &Function);
   void *getFunctionPointer(const std::string &functionName);
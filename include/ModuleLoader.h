@@ -14,13 +14,20 @@ namespace mull {
 
 class ModuleLoader {
   llvm::LLVMContext &Ctx;
+  unsigned workers;
+  bool lazy;
 
 public:
-  ModuleLoader(llvm::LLVMContext &C) : Ctx(C) {}
+  /// Lazily loaded modules have their function bodies read on demand,
+  /// see MullModule::materialize
+  ModuleLoader(llvm::LLVMContext &C, unsigned workers = 1, bool lazy = false)
+    : Ctx(C), workers(workers), lazy(lazy) {}
   virtual ~ModuleLoader() {}
 
   virtual std::unique_ptr<MullModule> loadModuleAtPath(const std::string &path);
 
+  /// With more than one worker the modules are parsed in parallel, each into
+  /// an LLVMContext of its own. The modules keep the order of the list.
   virtual std::vector<std::unique_ptr<MullModule>>
     loadModulesFromBitcodeFileList(const std::vector<std::string> &path);
 };
@@ -1,27 +1,42 @@
 #pragma once 
 
+#include <cstdint>
 #include <string>
 
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
-namespace llvm {
-class LLVMContext;
-}
-
 namespace mull {
 
   class MullModule {
+    /// Set when the module was parsed into a context of its own,
+    /// destroyed after the module
+    std::unique_ptr<llvm::LLVMContext> ownedContext;
     std::unique_ptr<llvm::Module> module;
     std::string uniqueIdentifier;
+    uint64_t identifierHash;
     std::string modulePath;
     MullModule(std::unique_ptr<llvm::Module> llvmModule);
   public:
     MullModule(std::unique_ptr<llvm::Module> llvmModule,
-               const std::string &md5,
+               const std::string &hash,
+               const std::string &path);
+    MullModule(std::unique_ptr<llvm::LLVMContext> context,
+               std::unique_ptr<llvm::Module> llvmModule,
+               const std::string &hash,
                const std::string &path);
 
     std::unique_ptr<MullModule> clone(llvm::LLVMContext &context);
 
+    /// Reads the body of a function of a lazily loaded module, does nothing
+    /// if the body is already there
+    static void materialize(llvm::Function *function);
+
+    /// Drops the bodies of the functions and the debug info to save memory.
+    /// The functions remain as declarations, mutants are compiled from
+    /// clones read from the bitcode file.
+    void releaseFunctionBodies();
+
     llvm::Module *getModule() {
       assert(module.get());
       return module.get();
@@ -32,12 +47,13 @@ namespace mull {
       return module.get();
     }
 
-    std::string getUniqueIdentifier() {
+    const std::string &getUniqueIdentifier() const {
       return uniqueIdentifier;
     }
 
-    std::string getUniqueIdentifier() const {
-      return uniqueIdentifier;
+    /// Hash of the unique identifier, used as a compact key in caches
+    uint64_t getIdentifierHash() const {
+      return identifierHash;
     }
   };
 
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+
+}
+
+namespace mull {
+
+class MullModule;
+class MutationPoint;
+
+/// \brief Table of slots that select which mutant of a function runs.
+///
+/// Normally each mutant is compiled into its own copy of the module, and
+/// every run links that copy along with the rest of the program. Instead,
+/// addDispatcher puts all the mutants of a function into one copy of the
+/// module. The function becomes a dispatcher that reads its slot and calls
+/// either the original body (slot 0) or the mutant with the matching number.
+/// The copy is compiled and linked once, and activating a mutant is a single
+/// store into the table.
+///
+/// The slots live in the memory of the process. A forked child activates the
+/// mutant in its own copy, which leaves the slots of the parent untouched.
+class MutantSlots {
+  /// Elements of a deque never move, the dispatchers refer to them by address
+  std::deque<uint64_t> slots;
+  std::map<llvm::Function *, uint64_t *> functionSlots;
+
+  uint64_t *slotOf(llvm::Function *function);
+
+public:
+  /// Whether calls to the function can be routed through a dispatcher.
+  /// Only the signature is checked, the body may be released by now.
+  static bool canDispatch(llvm::Function &function);
+
+  /// Rewrites the clone of the module of the function: the function
+  /// dispatches to its original body or to the mutant of
+  /// mutationPoints[slot - 1].
+  void addDispatcher(MullModule &clone,
+                     llvm::Function *function,
+                     const std::vector<MutationPoint *> &mutationPoints);
+
+  /// The mutant to call, 1-based, or 0 for the original body
+  void activate(llvm::Function *function, uint64_t mutant);
+  void deactivate(llvm::Function *function);
+};
+
+}
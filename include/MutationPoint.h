@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <memory>
@@ -28,26 +29,20 @@ class MutationPointAddress {
   int BBIndex;
   int IIndex;
 
-  std::string identifier;
 public:
   MutationPointAddress(int FnIndex, int BBIndex, int IIndex) :
-    FnIndex(FnIndex), BBIndex(BBIndex), IIndex(IIndex) {
+    FnIndex(FnIndex), BBIndex(BBIndex), IIndex(IIndex) {}
 
-    identifier = std::to_string(FnIndex) + "_" +
-      std::to_string(BBIndex) + "_" +
-      std::to_string(IIndex);
-  }
-
-  int getFnIndex() { return FnIndex; }
-  int getBBIndex() { return BBIndex; }
-  int getIIndex() { return IIndex; }
-
-  std::string getIdentifier() {
-    return identifier;
-  }
+  int getFnIndex() const { return FnIndex; }
+  int getBBIndex() const { return BBIndex; }
+  int getIIndex() const { return IIndex; }
 
+  /// Human-readable form of the address, e.g. "2_3_5".
+  /// Built on demand: it is only needed for reporting and on-disk caching.
   std::string getIdentifier() const {
-    return identifier;
+    return std::to_string(FnIndex) + "_" +
+      std::to_string(BBIndex) + "_" +
+      std::to_string(IIndex);
   }
 
   llvm::Instruction &findInstruction(llvm::Module *module);
@@ -60,13 +55,40 @@ public:
                                                         int)>& block);
 };
 
+/// Compact identifier of a mutation point.
+/// It is a hash of the module's unique identifier, the address and the
+/// mutation operator, therefore it is stable within a run and can be used as
+/// a key in hash maps instead of the concatenated string identifier.
+typedef uint64_t MutationPointID;
+
+/// \brief Position of a mutation point in the sources, copied from the debug
+/// info when the point is found.
+struct SourceLocation {
+  std::string fileName;
+  std::string directory;
+  int line;
+  int column;
+
+  SourceLocation() : line(0), column(0) {}
+
+  /// Instructions without debug info have no location
+  bool isNull() const {
+    return fileName.empty();
+  }
+};
+
+/// Everything needed to report a mutation point is copied out of the IR in
+/// the constructor, so that the bodies of the functions can be released
+/// before the mutants run (see MullModule::releaseFunctionBodies).
 class MutationPoint {
   MutationOperator *mutationOperator;
   MutationPointAddress Address;
   llvm::Value *OriginalValue;
   MullModule *module;
-  std::string uniqueIdentifier;
+  MutationPointID identifierHash;
   std::string diagnostics;
+  std::string functionName;
+  SourceLocation sourceLocation;
 
 public:
   MutationPoint(MutationOperator *op,
@@ -79,6 +101,8 @@ public:
 
   MutationOperator *getOperator();
   MutationPointAddress getAddress();
+
+  /// Dangles once the function bodies are released
   llvm::Value *getOriginalValue();
   MullModule *getOriginalModule();
 
@@ -89,11 +113,18 @@ public:
 
   void applyMutation(MullModule &module);
 
-  std::string getUniqueIdentifier();
+  MutationPointID getIdentifierHash() const;
+
+  /// Builds the human-readable identifier:
+  /// <module identifier>_<address>_<operator>.
+  /// Prefer getIdentifierHash() for lookups, this one is meant for reporting.
   std::string getUniqueIdentifier() const;
 
   const std::string &getDiagnostics();
   const std::string &getDiagnostics() const;
+
+  const std::string &getFunctionName() const;
+  const SourceLocation &getSourceLocation() const;
 };
 
 }
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "MutationOperators/MutationOperator.h"
 #include "MutationPoint.h"
 
+namespace llvm {
+  class Function;
+}
+
 namespace mull {
   class Context;
   class Filter;
@@ -13,10 +18,30 @@ namespace mull {
   class MutationsFinder {
     std::vector<std::unique_ptr<MutationOperator>> operators;
     std::vector<std::unique_ptr<MutationPoint>> ownedPoints;
+    std::map<llvm::Function *, std::vector<MutationPoint *>> cachedPoints;
   public:
     MutationsFinder(std::vector<std::unique_ptr<MutationOperator>> operators);
+
+    /// Returns mutation points of the testee's function.
+    /// The points are searched for only once per function, subsequent
+    /// calls (or calls after findMutationPoints) return the cached ones.
     std::vector<MutationPoint *> getMutationPoints(const Context &context,
                                                    Testee &testee,
                                                    Filter &filter);
+
+    /// Searches for mutation points of all the functions in parallel.
+    /// The IR is only read at this stage, so each function is processed
+    /// independently on a pool of `workers` threads. The results are merged
+    /// in the order of `functions`, hence they do not depend on scheduling.
+    void findMutationPoints(const Context &context,
+                            const std::vector<llvm::Function *> &functions,
+                            Filter &filter,
+                            unsigned workers);
+
+  private:
+    std::vector<std::unique_ptr<MutationPoint>>
+      findMutationPointsInFunction(const Context &context,
+                                   llvm::Function *function,
+                                   Filter &filter);
   };
 }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "TestResult.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}
+
+namespace mull {
+
+/// \brief Periodically prints how far a run got: the number of mutants
+/// executed, their throughput, the verdicts so far and an estimate of the
+/// remaining time.
+///
+/// The estimate is based on the observed cost of each test: the remaining
+/// mutants of a test are expected to take as long as its finished mutants
+/// did on average. Tests that did not run any mutant yet are estimated from
+/// their baseline running time, scaled by how much slower the mutants of
+/// the other tests were compared to their baselines. Mutants that did not
+/// have to run (reused, equivalent or aliases) count as finished, but their
+/// near zero times are not taken as samples of the cost.
+class ProgressReporter {
+public:
+  enum class Format {
+    None,
+    Text,
+    JSON
+  };
+
+  static Format formatFromString(const std::string &format);
+
+  ProgressReporter(Format format, int intervalSeconds, llvm::raw_ostream &out);
+
+  /// Registers a test with `mutants` mutants to be run against it,
+  /// returns the identifier of the test for mutantFinished()
+  int addTest(long long baselineMilliseconds, int mutants);
+
+  /// Starts the clock, the throughput is measured from this point
+  void start();
+
+  /// Prints the progress if the interval has passed since the last report.
+  /// A skipped mutant did not run, its time is not a sample of the cost.
+  void mutantFinished(int test, ExecutionStatus status,
+                      long long milliseconds, bool skipped = false);
+
+  /// Prints the final state regardless of the interval
+  void finish();
+
+  int finishedMutants() const { return finished; }
+  int plannedMutants() const { return planned; }
+  long long estimateRemainingMilliseconds() const;
+
+  std::string textReport() const;
+  std::string jsonReport() const;
+
+private:
+  struct TestProgress {
+    long long baselineMilliseconds;
+    int planned;
+    int finished;
+    int sampled;
+    long long spentMilliseconds;
+  };
+
+  Format format;
+  std::chrono::seconds interval;
+  llvm::raw_ostream &out;
+
+  std::vector<TestProgress> tests;
+  int planned;
+  int finished;
+  int killed;
+  int survived;
+  int timedOut;
+  int other;
+
+  std::chrono::steady_clock::time_point startTime;
+  std::chrono::steady_clock::time_point lastReportTime;
+
+  double mutantsPerSecond() const;
+  void report();
+};
+
+}
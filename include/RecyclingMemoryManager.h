@@ -0,0 +1,88 @@
+#pragma once
+
+#include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
+
+#include <string>
+#include <vector>
+
+namespace mull {
+
+/// \brief Memory manager that links every run into the same memory.
+///
+/// SectionMemoryManager maps and protects new pages for each section on each
+/// run. This one reserves one region when constructed, hands out sections
+/// from it by bumping a pointer, and changes the protection of the code once
+/// per run. reset() makes the whole region available again, so a test runner
+/// that lives across runs keeps touching the same, already faulted in pages.
+/// The region is reserved in the parent and inherited by every forked child.
+///
+/// Read-only data stays writable: it shares the pages with the other data.
+class RecyclingMemoryManager : public llvm::RTDyldMemoryManager {
+  struct Arena {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    /// Code below this offset is already executable
+    size_t finalized;
+  };
+
+  struct Mapping {
+    uint8_t *address;
+    size_t size;
+    bool isCode;
+    bool finalized;
+  };
+
+  struct EHFrame {
+    uint8_t *address;
+    uint64_t loadAddress;
+    size_t size;
+  };
+
+  uint8_t *region;
+  size_t regionSize;
+  Arena code;
+  Arena data;
+
+  /// Sections that did not fit into the region
+  std::vector<Mapping> overflow;
+  std::vector<EHFrame> frames;
+
+  uint8_t *allocate(Arena &arena, uintptr_t size, unsigned alignment,
+                    bool isCode);
+  uint8_t *allocateOverflow(uintptr_t size, bool isCode);
+
+public:
+  static const size_t DefaultReservation = 256 * 1024 * 1024;
+
+  explicit RecyclingMemoryManager(size_t reservation = DefaultReservation);
+  ~RecyclingMemoryManager() override;
+
+  RecyclingMemoryManager(const RecyclingMemoryManager &) = delete;
+  RecyclingMemoryManager &operator=(const RecyclingMemoryManager &) = delete;
+
+  uint8_t *allocateCodeSection(uintptr_t size, unsigned alignment,
+                               unsigned sectionID,
+                               llvm::StringRef sectionName) override;
+
+  uint8_t *allocateDataSection(uintptr_t size, unsigned alignment,
+                               unsigned sectionID,
+                               llvm::StringRef sectionName,
+                               bool isReadOnly) override;
+
+  bool finalizeMemory(std::string *errorMessage = nullptr) override;
+
+  void registerEHFrames(uint8_t *address, uint64_t loadAddress,
+                        size_t size) override;
+  void deregisterEHFrames(uint8_t *address, uint64_t loadAddress,
+                          size_t size) override;
+
+  /// Makes all the memory available again. The objects linked into it
+  /// must be removed from the linking layer before this call.
+  void reset();
+
+  size_t bytesInUse() const;
+  size_t overflowMappings() const { return overflow.size(); }
+};
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "TestResult.h"
+
+#include <map>
+#include <string>
+
+namespace mull {
+
+/// \brief Verdicts of an earlier run, used to skip mutants that cannot have
+/// changed since.
+///
+/// A verdict is reused when the test and the mutated function both have
+/// the same hash as in the earlier run (see FunctionHasher), and the mutant
+/// is at the same place in the function and made by the same operator.
+class ResultHistory {
+  std::map<std::string, ExecutionResult> results;
+
+  static std::string key(const std::string &testName,
+                         const std::string &testHash,
+                         const std::string &functionName,
+                         const std::string &functionHash,
+                         int basicBlockIndex,
+                         int instructionIndex,
+                         const std::string &mutationOperator);
+public:
+  /// Loads the results database written by SQLiteReporter
+  void load(const std::string &databasePath);
+
+  bool lookup(TestResult &testResult,
+              MutationPoint &mutationPoint,
+              const std::string &functionHash,
+              ExecutionResult &result) const;
+
+  size_t size() const { return results.size(); }
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Config;
+class MutationPoint;
+class MutationResult;
+class TestResult;
+struct ResultTime;
+
+/// Receives results while Driver produces them, so that they can be written
+/// out right away instead of being accumulated until the end of the run.
+class ResultSink {
+public:
+  /// Called once the modules are loaded, before any result is reported.
+  /// bitcodeHashes are the unique identifiers of the loaded modules.
+  virtual void begin(const Config &config,
+                     const std::vector<std::string> &bitcodeHashes) = 0;
+
+  /// Whether the result of running the test against the mutant is already
+  /// known, e.g. recorded by an earlier run that got interrupted
+  virtual bool isReported(TestResult &testResult,
+                          MutationPoint &mutationPoint) = 0;
+
+  /// Called once a test passed without mutations, before any of its mutants
+  virtual void reportTest(TestResult &testResult) = 0;
+
+  /// Called right after a mutant has been run against a test
+  virtual void reportMutant(TestResult &testResult,
+                            MutationResult &mutationResult) = 0;
+
+  /// Called once after the last result has been reported
+  virtual void finish(const Config &config, const ResultTime &resultTime) = 0;
+
+  virtual ~ResultSink() {};
+};
+
+}
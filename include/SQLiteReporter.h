@@ -1,27 +1,114 @@
 #include "Result.h"
+#include "ResultSink.h"
 
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <memory>
 
+struct sqlite3;
+struct sqlite3_stmt;
+
 namespace mull {
 
 class Result;
 class Config;
 
-class SQLiteReporter {
+class SQLiteReporter : public ResultSink {
 
 private:
   std::string databasePath;
 
+  sqlite3 *database;
+  sqlite3_stmt *insertExecutionStmt;
+  sqlite3_stmt *selectOutputBlobStmt;
+  sqlite3_stmt *insertOutputBlobStmt;
+  sqlite3_stmt *selectTestStmt;
+  sqlite3_stmt *insertTestStmt;
+  sqlite3_stmt *selectMutationPointStmt;
+  sqlite3_stmt *insertMutationPointStmt;
+  sqlite3_stmt *insertMutationPointDebugStmt;
+  sqlite3_stmt *insertMutationExecutionStmt;
+
+  /// Number of rows written since the last commit
+  int pendingRows;
+
+  /// Whether mutation_point_debug should be filled in
+  bool emitDebugInfo;
+
+  /// Drop the output of mutants that survived, were equivalent or not run
+  bool keepOutputOnlyForKilledMutants;
+
+  /// Appending to the database of an interrupted run
+  bool resuming;
+  /// Row ids of the tests written so far, by test name
+  std::map<std::string, int64_t> testIDs;
+  /// Pairs of test name and mutation point unique identifier
+  std::set<std::pair<std::string, std::string>> reportedMutants;
+
+  void open();
+  void loadReportedResults();
+
+  /// Insert the row unless it is in the database already, return its id
+  int64_t insertTest(TestResult &testResult);
+  int64_t insertMutationPoint(MutationPoint &mutationPoint,
+                              const std::string &functionHash);
+  int64_t insertOutput(const std::string &output);
+  int64_t insertExecutionResult(const ExecutionResult &result, bool keepOutput);
+  void close();
+  void rowInserted();
+
 public:
+  /// Version of the database layout, stored in PRAGMA user_version
+  static const int SchemaVersion = 9;
+
+  /// Rows are committed in batches of this size while streaming
+  static const int BatchSize = 1000;
+
   SQLiteReporter(const std::string &projectName = std::string(""));
+  ~SQLiteReporter();
 
   void reportResults(const std::unique_ptr<Result> &result,
                      const Config &config,
                      const ResultTime &resultTime);
 
+  /// Only affects mutation points reported after the call
+  void setEmitDebugInfo(bool emit) { emitDebugInfo = emit; }
+
+  /// Only affects results reported after the call
+  void setKeepOutputOnlyForKilledMutants(bool keep) {
+    keepOutputOnlyForKilledMutants = keep;
+  }
+
+  /// Appends to the database at databasePath instead of creating a new one.
+  /// Mutants recorded there are reported as done, and begin() refuses to
+  /// continue if the config or the bitcode differ from the recorded ones.
+  void resumeFrom(const std::string &databasePath);
+
+  void begin(const Config &config,
+             const std::vector<std::string> &bitcodeHashes) override;
+  bool isReported(TestResult &testResult,
+                  MutationPoint &mutationPoint) override;
+  void reportTest(TestResult &testResult) override;
+  void reportMutant(TestResult &testResult,
+                    MutationResult &mutationResult) override;
+  void finish(const Config &config, const ResultTime &resultTime) override;
+
   std::string getDatabasePath();
+
+  /// Defines sqlar_uncompress(data, size) on the connection, the function
+  /// the execution_output view reads compressed outputs with. The sqlite3
+  /// shell built with zlib provides the same function. Other clients read
+  /// the execution_result view, which shows compressed outputs as NULL.
+  static void registerFunctions(sqlite3 *database);
+
+  /// Combines the databases written by the shards of a run into one.
+  /// Tests and mutation points reported by several shards are stored once.
+  /// Merging into the output of an earlier merge adds the new shards to it,
+  /// shards merged before are not added twice.
+  static void mergeDatabases(const std::string &outputPath,
+                             const std::vector<std::string> &inputPaths);
 };
 
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class MutationPoint;
+
+/// \brief Splits the mutants of a run between several independent runs
+/// (shards), e.g. on different machines.
+///
+/// Every shard must come up with the same partition on its own, so the
+/// partition only depends on inputs all the shards see the same way: the
+/// mutants' unique identifiers and their static costs, the number of tests
+/// each mutant has to be run against. Timings measured by each shard would
+/// differ between them. The mutants are assigned greedily, most expensive
+/// first, each to the least loaded shard.
+class ShardPartition {
+  int shardIndex;
+  int shardCount;
+  std::map<MutationPoint *, uint64_t> costs;
+  std::set<MutationPoint *> ownMutants;
+
+public:
+  ShardPartition(int shardIndex, int shardCount);
+
+  /// Accumulates the cost: call once per test the mutant is run against
+  void addMutant(MutationPoint *mutationPoint);
+
+  void partition();
+
+  /// Whether this shard runs the mutant. Must be called after partition().
+  bool contains(MutationPoint *mutationPoint) const;
+
+  size_t size() const { return ownMutants.size(); }
+  bool isSharded() const { return shardCount > 1; }
+};
+
+}
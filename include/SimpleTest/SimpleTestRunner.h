@@ -18,11 +18,21 @@ class Test;
 
 class SimpleTestRunner : public TestRunner {
   llvm::orc::ObjectLinkingLayer<> ObjectLayer;
+  llvm::orc::ObjectLinkingLayer<>::ObjSetHandleT linkedObjects;
   llvm::Mangler Mangler;
 public:
   SimpleTestRunner(llvm::TargetMachine &targetMachine);
   ExecutionStatus runTest(Test *test, TestRunner::ObjectFiles &objectFiles) override;
 
+  bool supportsBatching() override { return true; }
+  ExecutionStatus runTests(std::vector<Test *> &tests,
+                           TestRunner::ObjectFiles &objectFiles) override;
+
+  bool supportsLinkingAhead() override { return true; }
+  void linkObjectFiles(TestRunner::ObjectFiles &objectFiles) override;
+  ExecutionStatus runLinkedTests(std::vector<Test *> &tests) override;
+  void unlinkObjectFiles() override;
+
 private:
   std::string MangleName(const llvm::StringRef &Name);
   void *TestFunctionPointer(const llvm::Function &Function);
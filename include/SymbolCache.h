@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace llvm {
+namespace object {
+class ObjectFile;
+}
+}
+
+namespace mull {
+
+/// \brief Memoizes the addresses of symbols found in the current process,
+/// which the JIT resolvers would otherwise look up with dlsym for every
+/// external symbol on every link.
+///
+/// The cache is filled in the parent before the tests run, once the dynamic
+/// libraries are loaded, so that every forked child inherits it. prefetch
+/// also remembers the symbols it cannot find, they cannot appear later.
+/// Lookups on demand cache only the symbols they find. Since a newly loaded
+/// library may shadow a cached symbol, the cache is tied to the list of
+/// dynamic libraries and is dropped when the list changes.
+///
+/// Symbols that mull itself provides to the JITted code are defined
+/// separately and survive that.
+class SymbolCache {
+public:
+  SymbolCache() = delete;
+
+  /// Address of the symbol in the current process, 0 if not found
+  static uint64_t getSymbolAddress(const std::string &name);
+
+  /// Makes the name resolve to the address, ahead of the process symbols
+  static void define(const std::string &name, uint64_t address);
+
+  /// Resolves the undefined symbols of the object files ahead of time.
+  /// The dynamic libraries must be loaded by then.
+  static void prefetch(const std::vector<llvm::object::ObjectFile *> &objectFiles,
+                       const std::vector<std::string> &dynamicLibraries);
+
+  static size_t size();
+
+  /// Forgets the cached and the defined symbols. Only tests need this.
+  static void clear();
+};
+
+}
@@ -23,7 +23,8 @@ enum ExecutionStatus {
   Timedout = 3,
   Crashed = 4,
   AbnormalExit = 5,
-  DryRun = 6
+  DryRun = 6,
+  Equivalent = 7
 };
 
 struct ExecutionResult {
@@ -49,6 +50,8 @@ struct ExecutionResult {
         return "AbnormalExit";
       case DryRun:
         return "DryRun";
+      case Equivalent:
+        return "Equivalent";
     }
   }
 };
@@ -57,13 +60,23 @@ class MutationResult {
   ExecutionResult Result;
   MutationPoint *MutPoint;
   int distance;
+  MutationPoint *aliasOf;
+  std::string functionHash;
 
 public:
-  MutationResult(ExecutionResult R, mull::MutationPoint *MP, int distance);
+  MutationResult(ExecutionResult R, mull::MutationPoint *MP, int distance,
+                 mull::MutationPoint *aliasOf = nullptr);
 
   ExecutionResult getExecutionResult()  { return Result; }
   MutationPoint* getMutationPoint()     { return MutPoint; }
   int getMutationDistance()             { return distance; }
+  /// The mutant compiles to the same code as this one, the result was taken
+  /// from its run instead of running this mutant.
+  MutationPoint* getAliasOf()           { return aliasOf; }
+
+  /// Hash of the mutated function and its callees, see FunctionHasher
+  const std::string &getFunctionHash()  { return functionHash; }
+  void setFunctionHash(const std::string &hash) { functionHash = hash; }
 };
 
 class TestResult {
@@ -71,6 +84,8 @@ class TestResult {
   ExecutionResult OriginalTestResult;
   std::unique_ptr<Test> TestPtr;
   std::vector<std::unique_ptr<MutationResult>> MutationResults;
+  /// Hash of the test function and its callees, see FunctionHasher
+  std::string testHash;
 public:
   TestResult(ExecutionResult OriginalResult, std::unique_ptr<Test> T);
 
@@ -78,9 +93,13 @@ public:
 
   std::string getTestName();
   std::string getDisplayName();
+  Test *getTest();
 
   std::vector<std::unique_ptr<MutationResult>> &getMutationResults();
   ExecutionResult getOriginalTestResult();
+
+  const std::string &getTestHash() { return testHash; }
+  void setTestHash(const std::string &hash) { testHash = hash; }
 };
 
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "RecyclingMemoryManager.h"
 #include "TestResult.h"
 
+#include <cassert>
+#include <vector>
+
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Target/TargetMachine.h"
@@ -13,6 +17,8 @@ class Test;
 class TestRunner {
 protected:
   llvm::TargetMachine &machine;
+  /// Every run links the object files into the same memory
+  RecyclingMemoryManager memoryManager;
 public:
   typedef std::vector<llvm::object::ObjectFile *> ObjectFiles;
   typedef std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> OwnedObjectFiles;
@@ -20,6 +26,34 @@ public:
 
   virtual ExecutionStatus runTest(Test *test, ObjectFiles &objectFiles) = 0;
 
+  /// Whether runTests can run several tests in one process
+  virtual bool supportsBatching() { return false; }
+
+  /// Runs the tests one after another in the current process, linking the
+  /// object files once. Passes only if every test passes.
+  virtual ExecutionStatus runTests(std::vector<Test *> &tests,
+                                   ObjectFiles &objectFiles) {
+    assert(false && "The test framework cannot run tests in batches");
+    return ExecutionStatus::Invalid;
+  }
+
+  /// Whether the object files can be linked once ahead of several runs
+  virtual bool supportsLinkingAhead() { return false; }
+
+  /// Links the object files into the current process. Until unlinkObjectFiles
+  /// is called, runLinkedTests runs tests against them without linking again,
+  /// e.g. in processes forked after this call.
+  virtual void linkObjectFiles(ObjectFiles &objectFiles) {
+    assert(false && "The test framework cannot link ahead of the runs");
+  }
+  virtual ExecutionStatus runLinkedTests(std::vector<Test *> &tests) {
+    assert(false && "The test framework cannot link ahead of the runs");
+    return ExecutionStatus::Invalid;
+  }
+  virtual void unlinkObjectFiles() {
+    assert(false && "The test framework cannot link ahead of the runs");
+  }
+
   virtual ~TestRunner() {}
 };
 
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+namespace mull {
+
+/// \brief How much work goes into generating the code of an object.
+///
+///   Fast       no IR optimizations, -O0 code generation with FastISel
+///   Default    the settings the target machine was created with
+///   Optimized  scalar IR optimizations and -O3 code generation
+enum class CodegenProfile {
+  Fast,
+  Default,
+  Optimized
+};
+
+/// 'fast' and 'optimized' name their profiles, anything else is Default
+CodegenProfile codegenProfileFromString(const std::string &name);
+
+/// \brief Picks the codegen profile for the objects of one phase.
+///
+/// 'fast', 'default' and 'optimized' always pick the same profile. 'auto'
+/// weighs the time a test takes against the time compiling a mutant took
+/// with the default profile so far: compiling quickly pays off when the
+/// compilation dominates, optimizing pays off when the test does. Once it
+/// picks the other profiles, every DefaultSamplingInterval-th compilation
+/// still uses the default profile to keep its time up to date.
+class CodegenProfileSelector {
+  bool automatic;
+  CodegenProfile profile;
+  long long compileTimes[3];
+  int compiles[3];
+  int compilesSinceDefault;
+
+public:
+  explicit CodegenProfileSelector(const std::string &name);
+
+  /// The running time of the test is in milliseconds
+  CodegenProfile select(long long testTime) const;
+
+  /// Records how many milliseconds compiling an object took
+  void addCompileTime(CodegenProfile usedProfile, long long compileTime);
+
+  /// Average over the objects compiled with the profile, 0 if there are none
+  long long averageCompileTime(CodegenProfile usedProfile) const;
+};
+
+}
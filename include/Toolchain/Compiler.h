@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Toolchain/CodegenProfile.h"
+
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
 
@@ -18,7 +20,13 @@ class Compiler {
   llvm::TargetMachine &targetMachine;
 public:
   Compiler(llvm::TargetMachine &machine);
-  llvm::object::OwningBinary<llvm::object::ObjectFile> compileModule(const MullModule &module);
-  llvm::object::OwningBinary<llvm::object::ObjectFile> compileModule(llvm::Module *module);
+  llvm::object::OwningBinary<llvm::object::ObjectFile>
+    compileModule(const MullModule &module,
+                  CodegenProfile profile = CodegenProfile::Default);
+
+  /// The optimized profile changes the IR of the module in place
+  llvm::object::OwningBinary<llvm::object::ObjectFile>
+    compileModule(llvm::Module *module,
+                  CodegenProfile profile = CodegenProfile::Default);
 };
 }
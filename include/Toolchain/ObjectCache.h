@@ -1,41 +1,132 @@
 #pragma once
 
+#include "Toolchain/CodegenProfile.h"
+
 #include "llvm/Object/ObjectFile.h"
 
+#include <cstdint>
+#include <list>
 #include <string>
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace mull {
   class MullModule;
+  class MutationOperator;
   class MutationPoint;
 
   class ObjectCache {
-    std::map<std::string, llvm::object::OwningBinary<llvm::object::ObjectFile>> inMemoryCache;
+    /// Identifies an object exactly, so that mutants whose identifier hashes
+    /// collide still get objects of their own. The hash (see
+    /// MullModule::getIdentifierHash and MutationPoint::getIdentifierHash)
+    /// only picks the bucket. Original modules have no operator and no address,
+    /// dispatch objects have the address of the function and its mutants.
+    struct ObjectKey {
+      uint64_t identifierHash;
+      const MullModule *module;
+      const MutationOperator *mutationOperator;
+      int functionIndex;
+      int basicBlockIndex;
+      int instructionIndex;
+      CodegenProfile profile;
+      bool onDemand;
+      std::vector<const MutationPoint *> dispatchedMutants;
+
+      bool operator==(const ObjectKey &other) const;
+    };
+
+    struct ObjectKeyHash {
+      size_t operator()(const ObjectKey &key) const {
+        return key.identifierHash;
+      }
+    };
+
+    typedef std::unordered_map<ObjectKey,
+                               llvm::object::OwningBinary<llvm::object::ObjectFile>,
+                               ObjectKeyHash>
+      InMemoryCacheType;
+
+    /// Mutant objects are mostly used once, they are kept in the order of
+    /// their last use so that the least recently used go first once the
+    /// budget is exceeded
+    struct MutantObject {
+      llvm::object::OwningBinary<llvm::object::ObjectFile> object;
+      std::list<ObjectKey>::iterator lastUse;
+    };
+
+    /// Objects are keyed by what they were compiled from, the codegen profile
+    /// they were compiled with and whether they were compiled on demand:
+    /// a module then calls its functions through stubs and a mutant holds
+    /// the mutated function only, see FunctionStubs.
+    /// Original modules are needed by every test run and are never evicted.
+    InMemoryCacheType moduleObjects;
+    std::unordered_map<ObjectKey, MutantObject, ObjectKeyHash> mutantObjects;
+    std::list<ObjectKey> mutantsByLastUse;
+    uint64_t mutantObjectsSize;
+    uint64_t mutantObjectsBudget;
     bool useOnDiskCache;
     std::string cacheDirectory;
 
   public:
-    ObjectCache(bool useCache, const std::string &cacheDir);
+    /// Mutant objects take up to mutantCacheSize bytes of memory,
+    /// 0 means no limit
+    ObjectCache(bool useCache, const std::string &cacheDir,
+                uint64_t mutantCacheSize);
 
-    llvm::object::ObjectFile *getObject(const MullModule &module);
-    llvm::object::ObjectFile *getObject(const MutationPoint &mutationPoint);
+    llvm::object::ObjectFile *getObject(const MullModule &module,
+                                        CodegenProfile profile,
+                                        bool onDemand);
+
+    /// The object stays valid until another mutant object is cached
+    llvm::object::ObjectFile *getObject(const MutationPoint &mutationPoint,
+                                        CodegenProfile profile,
+                                        bool onDemand);
 
     void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
-                   const MullModule &module);
+                   const MullModule &module,
+                   CodegenProfile profile,
+                   bool onDemand);
 
     void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
-                   const MutationPoint &mutationPoint);
+                   const MutationPoint &mutationPoint,
+                   CodegenProfile profile,
+                   bool onDemand);
+
+    /// All the mutants of a function compiled into one object, see
+    /// MutantSlots. Dispatch objects share the budget of the mutant objects,
+    /// and stay in memory only.
+    /// The object stays valid until another mutant object is cached
+    llvm::object::ObjectFile *
+      getDispatchObject(const std::vector<MutationPoint *> &mutationPoints,
+                        CodegenProfile profile);
+
+    void putDispatchObject(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
+                           const std::vector<MutationPoint *> &mutationPoints,
+                           CodegenProfile profile);
+
+    uint64_t getMutantObjectsSize() const {
+      return mutantObjectsSize;
+    }
 
   private:
-    llvm::object::ObjectFile *getObject(const std::string &identifier);
-    void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
-                   const std::string &identifier);
+    static ObjectKey moduleKey(const MullModule &module,
+                               CodegenProfile profile,
+                               bool onDemand);
+    static ObjectKey mutantKey(const MutationPoint &mutationPoint,
+                               CodegenProfile profile,
+                               bool onDemand);
+    static ObjectKey
+      dispatchKey(const std::vector<MutationPoint *> &mutationPoints,
+                  CodegenProfile profile);
+
+    llvm::object::OwningBinary<llvm::object::ObjectFile>
+      getObjectFromDisk(const std::string &identifier);
 
-    llvm::object::ObjectFile *getObjectFromMemory(const std::string &identifier);
-    llvm::object::ObjectFile *getObjectFromDisk(const std::string &identifier);
+    llvm::object::ObjectFile *
+      putMutantInMemory(const ObjectKey &key,
+                        llvm::object::OwningBinary<llvm::object::ObjectFile> object);
+    void evictMutants();
 
-    void putObjectInMemory(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
-                           const std::string &identifier);
     void putObjectOnDisk(llvm::object::OwningBinary<llvm::object::ObjectFile> &object,
                          const std::string &identifier);
   };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace mull {
+
+/// \brief Records how long each phase of a run takes.
+///
+/// The events can be written out in the Chrome trace event format
+/// (chrome://tracing, Perfetto) and summarized per phase. Every thread gets
+/// its own track. Events recorded in a forked child process, e.g. linking
+/// and running a test inside ForkProcessSandbox, are handed over to the
+/// parent through shared memory and shown on the 'sandbox' track.
+///
+/// Names and categories must be string literals: they are stored as
+/// pointers, which stay valid across fork().
+class Tracer {
+public:
+  Tracer() = delete;
+
+  static void enable();
+  static bool isEnabled();
+
+  static void record(const char *name, const char *category,
+                     uint64_t startMicroseconds, uint64_t durationMicroseconds);
+
+  /// Moves the events recorded by the last forked child to the parent
+  static void collectChildEvents();
+
+  static uint64_t nowMicroseconds();
+
+  static void writeChromeTrace(const std::string &path);
+  static void printSummary();
+};
+
+/// Records the lifetime of the scope as one event, or the time until
+/// finish() is called, whichever comes first
+class TraceScope {
+  const char *name;
+  const char *category;
+  uint64_t start;
+  bool finished;
+
+public:
+  TraceScope(const char *name, const char *category)
+    : name(name), category(category),
+      start(Tracer::isEnabled() ? Tracer::nowMicroseconds() : 0),
+      finished(false) {}
+
+  void finish() {
+    if (finished) {
+      return;
+    }
+    finished = true;
+    if (Tracer::isEnabled()) {
+      Tracer::record(name, category, start, Tracer::nowMicroseconds() - start);
+    }
+  }
+
+  ~TraceScope() {
+    finish();
+  }
+};
+
+}
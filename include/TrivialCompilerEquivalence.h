@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+
+}
+
+namespace mull {
+
+class MutationPoint;
+
+/// \brief Detects mutants that the compiler proves to be equivalent to the
+/// original code or to each other (Trivial Compiler Equivalence).
+///
+/// Each mutant is applied to a copy of its module, the mutated function is
+/// optimized and its body is hashed. A mutant whose hash matches the one of
+/// the original function is equivalent: no test can kill it. Mutants of the
+/// same function with matching hashes are duplicates: only the first of them
+/// needs to be run, the others are aliases of it.
+class TrivialCompilerEquivalence {
+  std::set<MutationPoint *> equivalentMutants;
+  std::map<MutationPoint *, MutationPoint *> aliases;
+
+public:
+  /// All the points must belong to the same function
+  void analyzeFunction(const std::vector<MutationPoint *> &mutationPoints);
+
+  bool isEquivalent(MutationPoint *mutationPoint) const;
+
+  /// Returns the first mutant with the same optimized code, or nullptr
+  /// if the mutant is unique
+  MutationPoint *aliasOf(MutationPoint *mutationPoint) const;
+
+  size_t equivalentMutantsCount() const { return equivalentMutants.size(); }
+  size_t aliasesCount() const { return aliases.size(); }
+
+  static std::string hashOptimizedFunction(llvm::Function &function);
+};
+
+}
@@ -0,0 +1,13 @@
+extern void log_call(void);
+
+/// x * 1 and x / 1 are both optimized to x: the mutant is equivalent
+int scale_by_one(int x) {
+  return x * 1;
+}
+
+/// Removing either of the calls leaves the same code: the second mutant
+/// is a duplicate of the first one
+void log_twice(void) {
+  log_call();
+  log_call();
+}
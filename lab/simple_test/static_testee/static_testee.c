@@ -0,0 +1,9 @@
+/// add is only visible inside of this module: compiled on demand, its
+/// mutants reach it through the exposed symbol
+static int add(int a, int b) {
+  return a + b;
+}
+
+int sum_of_three(int a, int b, int c) {
+  return add(add(a, b), c);
+}
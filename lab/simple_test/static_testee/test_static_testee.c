@@ -0,0 +1,9 @@
+extern int sum_of_three(int, int, int);
+
+int test_sum_of_three() {
+  return sum_of_three(1, 2, 3) == 6;
+}
+
+int test_sum_of_zeros() {
+  return sum_of_three(0, 0, 0) == 0;
+}
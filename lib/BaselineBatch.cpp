@@ -0,0 +1,110 @@
+#include "BaselineBatch.h"
+
+#include "DynamicCallTree.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <sys/mman.h>
+
+using namespace mull;
+using namespace std::chrono;
+
+static uint64_t nowMicroseconds() {
+  /// steady_clock is the same in the parent and in the forked child
+  auto now = steady_clock::now().time_since_epoch();
+  return duration_cast<microseconds>(now).count();
+}
+
+BaselineBatch::BaselineBatch(size_t functionsCount, int capacity)
+  : functionsCount(functionsCount), capacity(capacity),
+    mappings(nullptr), timings(nullptr),
+    activeSlot(capacity), activeDepth(0), running(false) {
+  assert(capacity > 0 && "Expected at least one test per batch");
+
+  mappings = (uint64_t *)mmap(NULL,
+                              sizeof(uint64_t) * functionsCount * (capacity + 1),
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS,
+                              -1,
+                              0);
+  timings = (uint64_t *)mmap(NULL,
+                             sizeof(uint64_t) * 2 * capacity,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_ANONYMOUS,
+                             -1,
+                             0);
+}
+
+BaselineBatch::~BaselineBatch() {
+  munmap(mappings, sizeof(uint64_t) * functionsCount * (capacity + 1));
+  munmap(timings, sizeof(uint64_t) * 2 * capacity);
+}
+
+void BaselineBatch::begin(const std::vector<std::vector<uint64_t>> &entryPointsOfTests) {
+  assert(entryPointsOfTests.size() <= (size_t)capacity);
+
+  memset(mappings, 0, sizeof(uint64_t) * functionsCount * (capacity + 1));
+  memset(timings, 0, sizeof(uint64_t) * 2 * capacity);
+
+  entryPoints.clear();
+  for (size_t slot = 0; slot < entryPointsOfTests.size(); slot++) {
+    for (uint64_t functionIndex : entryPointsOfTests[slot]) {
+      entryPoints[functionIndex] = slot;
+    }
+  }
+
+  activeSlot = scratchSlot();
+  activeDepth = 0;
+  running = true;
+}
+
+void BaselineBatch::end() {
+  running = false;
+}
+
+uint64_t *BaselineBatch::mapping(int slot) {
+  assert(slot >= 0 && slot <= capacity);
+  return mappings + functionsCount * slot;
+}
+
+void BaselineBatch::enterFunction(uint64_t functionIndex,
+                                  std::stack<uint64_t> &stack) {
+  auto entryPoint = entryPoints.find(functionIndex);
+  if (entryPoint != entryPoints.end() && entryPoint->second != activeSlot) {
+    activeSlot = entryPoint->second;
+    activeDepth = stack.size();
+    timings[2 * activeSlot] = nowMicroseconds();
+
+    /// The entry point is the root of the test's tree, no matter what
+    /// framework code called it
+    mapping(activeSlot)[functionIndex] = functionIndex;
+    stack.push(functionIndex);
+    return;
+  }
+
+  DynamicCallTree::enterFunction(functionIndex, mapping(activeSlot), stack);
+}
+
+void BaselineBatch::leaveFunction(uint64_t functionIndex,
+                                  std::stack<uint64_t> &stack) {
+  DynamicCallTree::leaveFunction(functionIndex, mapping(activeSlot), stack);
+
+  if (activeSlot != scratchSlot() && stack.size() == activeDepth) {
+    auto entryPoint = entryPoints.find(functionIndex);
+    if (entryPoint != entryPoints.end() && entryPoint->second == activeSlot) {
+      timings[2 * activeSlot + 1] = nowMicroseconds();
+      activeSlot = scratchSlot();
+    }
+  }
+}
+
+bool BaselineBatch::hasFinished(int slot) const {
+  assert(slot >= 0 && slot < capacity);
+  return timings[2 * slot] != 0 && timings[2 * slot + 1] != 0;
+}
+
+uint64_t BaselineBatch::runningTimeMicroseconds(int slot) const {
+  assert(hasFinished(slot));
+  return timings[2 * slot + 1] - timings[2 * slot];
+}
@@ -1,8 +1,8 @@
 #include "CustomTestFramework/CustomTestRunner.h"
 #include "CustomTestFramework/CustomTest_Test.h"
+#include "SymbolCache.h"
 
 #include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
-#include <llvm/ExecutionEngine/SectionMemoryManager.h>
 
 using namespace mull;
 using namespace llvm;
@@ -20,7 +20,7 @@ public:
       return symbol;
     }
 
-    if (auto address = RTDyldMemoryManager::getSymbolAddressInProcess(name)) {
+    if (auto address = SymbolCache::getSymbolAddress(name)) {
       return RuntimeDyld::SymbolInfo(address, JITSymbolFlags::Exported);
     }
 
@@ -74,7 +74,7 @@ ExecutionStatus CustomTestRunner::runTest(Test *test, ObjectFiles &objectFiles)
 
   auto Handle =
     ObjectLayer.addObjectSet(objectFiles,
-                             make_unique<SectionMemoryManager>(),
+                             &memoryManager,
                              make_unique<Mull_CustomTest_Resolver>(overrides));
 
   for (auto &constructor: customTest->getConstructors()) {
@@ -105,6 +105,7 @@ ExecutionStatus CustomTestRunner::runTest(Test *test, ObjectFiles &objectFiles)
   overrides.runDestructors();
 
   ObjectLayer.removeObjectSet(Handle);
+  memoryManager.reset();
 
   if (exitStatus == 0) {
     return ExecutionStatus::Passed;
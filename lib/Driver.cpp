@@ -2,13 +2,21 @@
 
 #include "Config.h"
 #include "Context.h"
+#include "FunctionHasher.h"
 #include "Logger.h"
+#include "ProgressReporter.h"
 #include "ModuleLoader.h"
 #include "Result.h"
+#include "ResultHistory.h"
+#include "ResultSink.h"
+#include "ShardPartition.h"
+#include "SymbolCache.h"
 #include "TestResult.h"
 #include "TestFinder.h"
 #include "TestRunner.h"
+#include "Tracer.h"
 #include "MutationsFinder.h"
+#include "TrivialCompilerEquivalence.h"
 
 #include <llvm/ExecutionEngine/Orc/JITSymbol.h>
 #include <llvm/IR/Constants.h>
@@ -23,6 +31,7 @@
 #include <algorithm>
 #include <chrono>
 #include <fstream>
+#include <set>
 #include <vector>
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -38,6 +47,11 @@ namespace mull {
 extern "C" void mull_enterFunction(Driver *driver, uint64_t functionIndex) {
   assert(driver);
   assert(driver->callTreeMapping());
+  BaselineBatch *batch = driver->baselineBatch();
+  if (batch && batch->isRunning()) {
+    batch->enterFunction(functionIndex, driver->callstack());
+    return;
+  }
   DynamicCallTree::enterFunction(functionIndex,
                                  driver->callTreeMapping(),
                                  driver->callstack());
@@ -46,6 +60,11 @@ extern "C" void mull_enterFunction(Driver *driver, uint64_t functionIndex) {
 extern "C" void mull_leaveFunction(Driver *driver, uint64_t functionIndex) {
   assert(driver);
   assert(driver->callTreeMapping());
+  BaselineBatch *batch = driver->baselineBatch();
+  if (batch && batch->isRunning()) {
+    batch->leaveFunction(functionIndex, driver->callstack());
+    return;
+  }
   DynamicCallTree::leaveFunction(functionIndex,
                                  driver->callTreeMapping(),
                                  driver->callstack());
@@ -86,32 +105,58 @@ std::unique_ptr<Result> Driver::Run() {
   std::vector<unique_ptr<MullModule>> modules =
     Loader.loadModulesFromBitcodeFileList(bitcodePaths);
 
+  std::vector<std::string> bitcodeHashes;
+  CodegenProfile baselineCodegen =
+    codegenProfileFromString(Cfg.getBaselineCodegen());
   for (auto &ownedModule : modules) {
     MullModule &module = *ownedModule.get();
     assert(ownedModule && "Can't load module");
+    bitcodeHashes.push_back(module.getUniqueIdentifier());
     Ctx.addModule(std::move(ownedModule));
 
-    ObjectFile *objectFile = toolchain.cache().getObject(module);
+    /// The functions are indexed and stubbed on a cache hit as well,
+    /// only the compilation of the instrumented module is skipped
+    LLVMContext localContext;
 
-    if (objectFile == nullptr) {
-      LLVMContext localContext;
+    auto clonedModule = module.clone(localContext);
 
-      auto clonedModule = module.clone(localContext);
+    TraceScope instrumentation("instrument module", "compile");
+    std::vector<std::pair<Function *, Function *>> clonedFunctions;
+    for (auto &function: module.getModule()->getFunctionList()) {
+      if (function.isDeclaration()) {
+        continue;
+      }
+      CallTreeFunction callTreeFunction(&function);
+      uint64_t index = functions.size();
+      functions.push_back(callTreeFunction);
+      auto clonedFunction = clonedModule->getModule()->getFunction(function.getName());
+      injectCallbacks(clonedFunction, index);
+      clonedFunctions.push_back(std::make_pair(&function, clonedFunction));
+    }
 
-      for (auto &function: module.getModule()->getFunctionList()) {
-        if (function.isDeclaration()) {
-          continue;
+    /// The local symbols are renamed, the clones are found by name above
+    if (Cfg.shouldCompileOnDemand()) {
+      FunctionStubs::exposeLocalSymbols(*clonedModule->getModule(),
+                                        module.getIdentifierHash());
+      for (auto &clonedFunction : clonedFunctions) {
+        if (FunctionStubs::canStub(*clonedFunction.second)) {
+          functionStubs.addStub(clonedFunction.first, clonedFunction.second);
         }
-        CallTreeFunction callTreeFunction(&function);
-        uint64_t index = functions.size();
-        functions.push_back(callTreeFunction);
-        auto clonedFunction = clonedModule->getModule()->getFunction(function.getName());
-        injectCallbacks(clonedFunction, index);
       }
+    }
+    instrumentation.finish();
+
+    ObjectFile *objectFile =
+      toolchain.cache().getObject(module, baselineCodegen,
+                                  Cfg.shouldCompileOnDemand());
 
-      auto owningObjectFile = toolchain.compiler().compileModule(*clonedModule.get());
+    if (objectFile == nullptr) {
+      TraceScope compilation("compile module", "compile");
+      auto owningObjectFile =
+        toolchain.compiler().compileModule(*clonedModule.get(), baselineCodegen);
       objectFile = owningObjectFile.getBinary();
-      toolchain.cache().putObject(std::move(owningObjectFile), module);
+      toolchain.cache().putObject(std::move(owningObjectFile), module,
+                                  baselineCodegen, Cfg.shouldCompileOnDemand());
     }
 
     InnerCache.insert(std::make_pair(module.getModule(), objectFile));
@@ -141,65 +186,231 @@ std::unique_ptr<Result> Driver::Run() {
     precompiledObjectFiles.push_back(std::move(owningObject));
   }
 
+  if (sink) {
+    sink->begin(Cfg, bitcodeHashes);
+  }
+
+  ResultHistory history;
+  if (!Cfg.getPreviousResultsPath().empty()) {
+    history.load(Cfg.getPreviousResultsPath());
+  }
+  int reusedResults = 0;
+
   prepareForExecution();
 
+  /// The libraries are loaded once, every forked child inherits them
+  TraceScope libraries("load dynamic libraries", "compile");
+  for (std::string &dylibPath: Cfg.getDynamicLibrariesPaths()) {
+    std::string errorMessage;
+    if (sys::DynamicLibrary::LoadLibraryPermanently(dylibPath.c_str(),
+                                                    &errorMessage)) {
+      Logger::error() << "Cannot load dynamic library: " << dylibPath
+                      << ": " << errorMessage << "\n";
+    }
+  }
+  libraries.finish();
+
+  /// Resolving external symbols here, in the parent, lets every forked
+  /// child reuse the addresses instead of looking them up on each link
+  if (Cfg.shouldPrelinkSymbols()) {
+    TraceScope symbolResolution("resolve symbols", "compile");
+    SymbolCache::prefetch(AllObjectFiles(), Cfg.getDynamicLibrariesPaths());
+    symbolResolution.finish();
+  }
+
+  TraceScope testDiscovery("find tests", "discovery");
   auto foundTests = Finder.findTests(Ctx, filter);
+  testDiscovery.finish();
   const int testsCount = foundTests.size();
 
   Logger::debug() << "Driver::Run> found "
                   << testsCount
                   << " tests\n";
 
-  int testIndex = 1;
-  for (auto &test : foundTests) {
-    auto ObjectFiles = AllObjectFiles();
+  /// Phase 1: running the original tests and collecting their testees
+
+  std::vector<BaselineRun> baselineRuns;
+
+  size_t batchSize = 1;
+  if (Runner.supportsBatching()) {
+    batchSize = Cfg.getBaselineBatchSize();
+  }
+  if (batchSize > 1) {
+    _baselineBatch = make_unique<BaselineBatch>(functions.size(), batchSize);
+    for (uint64_t index = 1; index < functions.size(); index++) {
+      functionIndices.insert(std::make_pair(functions[index].function, index));
+    }
+  }
+
+  for (size_t batchStart = 0; batchStart < foundTests.size(); batchStart += batchSize) {
+    size_t batchEnd = std::min(foundTests.size(), batchStart + batchSize);
 
     Logger::debug().indent(4)
-      << "Driver::Run> current test "
-      << "[" << testIndex++ << "/" << testsCount << "]: "
-      << test->getTestName()
+      << "Driver::Run> current tests "
+      << "[" << batchStart + 1 << "-" << batchEnd << "/" << testsCount << "]"
       << "\n";
 
-    _callstack = stack<uint64_t>();
-    memset(_callTreeMapping, 0, functions.size() * sizeof(_callTreeMapping[0]));
+    std::vector<std::unique_ptr<Test>> batch;
+    for (size_t index = batchStart; index < batchEnd; index++) {
+      batch.push_back(std::move(foundTests[index]));
+    }
 
-    ExecutionResult ExecResult = Sandbox->run([&]() {
-      for (std::string &dylibPath: Cfg.getDynamicLibrariesPaths()) {
-        sys::DynamicLibrary::LoadLibraryPermanently(dylibPath.c_str());
+    if (batch.size() > 1 && runBaselineBatch(batch, baselineRuns)) {
+      continue;
+    }
+
+    for (auto &test : batch) {
+      runBaseline(std::move(test), baselineRuns);
+    }
+  }
+
+  /// Hashes are saved with the results so that the next run can tell
+  /// which functions changed
+  FunctionHasher functionHasher;
+  {
+    TraceScope scope("hash functions", "discovery");
+    if (Cfg.shouldLoadBitcodeLazily()) {
+      /// Only the hashes of the testees are saved, hashing everything
+      /// else would read the bodies that were never needed
+      std::vector<Function *> roots;
+      for (BaselineRun &baselineRun : baselineRuns) {
+        for (auto &testee : baselineRun.testees) {
+          roots.push_back(testee->getTesteeFunction());
+        }
       }
+      functionHasher.computeHashes(Ctx, Cfg.getMaxDistance(), roots);
+    } else {
+      functionHasher.computeHashes(Ctx, Cfg.getMaxDistance());
+    }
+  }
 
-      return Runner.runTest(test.get(), ObjectFiles);
-    }, Cfg.getTimeout());
+  /// Phase 2: searching for mutation points of all the testees at once,
+  /// so that the search can be spread across several threads
 
-    if (ExecResult.status != Passed) {
-      Logger::error() << "error: Test has failed: " << test->getTestName() << "\n";
-      Logger::error() << "status: " << ExecResult.getStatusAsString() << "\n";
-      Logger::error() << "exit code: " << ExecResult.exitStatus << "\n";
-      Logger::error() << "stdout: " << ExecResult.stdoutOutput << "\n";
-      Logger::error() << "stderr: " << ExecResult.stderrOutput << "\n";
-      continue;
+  std::vector<Function *> testeeFunctions;
+  for (BaselineRun &baselineRun : baselineRuns) {
+    /// Skipping the first testee: it is the test itself
+    for (auto testee_it = std::next(baselineRun.testees.begin()),
+         ee = baselineRun.testees.end();
+         testee_it != ee;
+         ++testee_it) {
+      testeeFunctions.push_back((*testee_it)->getTesteeFunction());
     }
+  }
 
-    auto BorrowedTest = test.get();
-    auto Result = make_unique<TestResult>(ExecResult, std::move(test));
+  Logger::debug() << "Driver::Run> searching for mutation points in "
+                  << testeeFunctions.size() << " testees using "
+                  << Cfg.getWorkers() << " workers\n";
 
-    std::unique_ptr<CallTree> callTree(dynamicCallTree.createCallTree());
+  {
+    TraceScope scope("find mutation points", "discovery");
+    mutationsFinder.findMutationPoints(Ctx, testeeFunctions, filter,
+                                       Cfg.getWorkers());
+  }
 
-    auto subtrees = dynamicCallTree.extractTestSubtrees(callTree.get(), BorrowedTest);
-    auto testees = dynamicCallTree.createTestees(subtrees, BorrowedTest,
-                                                 Cfg.getMaxDistance(), filter);
+  TrivialCompilerEquivalence equivalence;
+  if (Cfg.shouldDetectEquivalentMutants() && !Cfg.isDryRun()) {
+    TraceScope scope("detect equivalent mutants", "discovery");
+    std::set<Function *> analyzedFunctions;
+    for (BaselineRun &baselineRun : baselineRuns) {
+      for (auto testee_it = std::next(baselineRun.testees.begin()),
+           ee = baselineRun.testees.end();
+           testee_it != ee;
+           ++testee_it) {
+        Testee &testee = *testee_it->get();
+        if (!analyzedFunctions.insert(testee.getTesteeFunction()).second) {
+          continue;
+        }
 
-    dynamicCallTree.cleanupCallTree(std::move(callTree));
-    if (testees.empty()) {
-      Logger::error() << "error: Coult not find any testees: " << BorrowedTest->getTestName() << "\n";
-      continue;
+        equivalence.analyzeFunction(mutationsFinder.getMutationPoints(Ctx,
+                                                                      testee,
+                                                                      filter));
+      }
+    }
+
+    Logger::debug() << "Driver::Run> found "
+                    << equivalence.equivalentMutantsCount()
+                    << " equivalent and "
+                    << equivalence.aliasesCount()
+                    << " duplicate mutants\n";
+  }
+
+  /// Every shard finds the same mutants and picks its own part of them
+  ShardPartition shard(Cfg.getShardIndex(), Cfg.getShardCount());
+  if (shard.isSharded()) {
+    for (BaselineRun &baselineRun : baselineRuns) {
+      for (auto testee_it = std::next(baselineRun.testees.begin()),
+           ee = baselineRun.testees.end();
+           testee_it != ee;
+           ++testee_it) {
+        for (auto mutationPoint : mutationsFinder.getMutationPoints(Ctx,
+                                                                   *testee_it->get(),
+                                                                   filter)) {
+          shard.addMutant(mutationPoint);
+        }
+      }
+    }
+    shard.partition();
+  }
+
+  /// The number of mutants each test is going to run against, for the ETA
+  ProgressReporter progress(ProgressReporter::formatFromString(Cfg.getProgress()),
+                            Cfg.getProgressInterval(),
+                            outs());
+  std::vector<int> progressTests;
+  for (BaselineRun &baselineRun : baselineRuns) {
+    int mutantsCount = 0;
+    for (auto testee_it = std::next(baselineRun.testees.begin()),
+         ee = baselineRun.testees.end();
+         testee_it != ee;
+         ++testee_it) {
+      for (auto mutationPoint : mutationsFinder.getMutationPoints(Ctx,
+                                                                 *testee_it->get(),
+                                                                 filter)) {
+        if (shard.contains(mutationPoint) &&
+            !(sink && sink->isReported(*baselineRun.result, *mutationPoint))) {
+          mutantsCount++;
+        }
+      }
+    }
+    long long baselineTime = baselineRun.result->getOriginalTestResult().runningTime;
+    progressTests.push_back(progress.addTest(baselineTime, mutantsCount));
+  }
+  progress.start();
+
+  /// Every mutation point is found and has what the reports need by now,
+  /// the mutants are compiled from clones read from the bitcode files
+  if (Cfg.shouldReleaseIR() && !Cfg.shouldEmitDebugInfo()) {
+    TraceScope scope("release IR", "discovery");
+    for (auto &module : Ctx.getModules()) {
+      module->releaseFunctionBodies();
+    }
+  }
+
+  /// Phase 3: running the tests against the mutants of their testees
+
+  for (size_t baselineIndex = 0; baselineIndex < baselineRuns.size(); baselineIndex++) {
+    BaselineRun &baselineRun = baselineRuns[baselineIndex];
+    std::unique_ptr<TestResult> &Result = baselineRun.result;
+    auto &testees = baselineRun.testees;
+    auto BorrowedTest = Result->getTest();
+    ExecutionResult ExecResult = Result->getOriginalTestResult();
+
+    /// The first testee is the test itself
+    Result->setTestHash(functionHasher.hashOf(testees.front()->getTesteeFunction()));
+
+    if (sink) {
+      TraceScope scope("report", "report");
+      sink->reportTest(*Result);
     }
 
     /// -1 since we are skipping the first testee
     const int testeesCount = testees.size() - 1;
 
     Logger::debug().indent(4)
-      << "Driver::Run> found "
+      << "Driver::Run> test "
+      << BorrowedTest->getTestName()
+      << ": found "
       << testeesCount << " testees\n";
 
     int testeeIndex = 1;
@@ -225,52 +436,188 @@ std::unique_ptr<Result> Driver::Run() {
       Logger::debug() << "against " << MPoints.size() << " mutation points\n";
       Logger::debug().indent(8) << "";
 
-      auto ObjectFiles = AllButOne(testee->getTesteeFunction()->getParent());
+      std::string functionHash = functionHasher.hashOf(testee->getTesteeFunction());
+
+      /// Results of the mutants of this testee, used to resolve aliases:
+      /// the mutant an alias refers to always comes first.
+      std::map<MutationPoint *, ExecutionResult> mutantResults;
+
+      /// A mutant compiled on demand holds only the testee, the original
+      /// module provides the rest and calls the mutant through the stub
+      Function *testeeFunction = testee->getTesteeFunction();
+      const bool onDemand = functionStubs.hasStub(testeeFunction);
+      auto ObjectFiles = onDemand ? AllObjectFiles() :
+        AllButOne(testeeFunction->getParent());
+
+      /// With mutant slots all the mutants of the testee share one object.
+      /// It is added before the first mutant that has to run, and when the
+      /// runs are forked it is linked once, right here in the parent.
+      const bool useSlots = !onDemand && Cfg.useMutantSlots() &&
+        MutantSlots::canDispatch(*testeeFunction);
+      const bool linkAhead = useSlots && Cfg.getFork() &&
+        Runner.supportsLinkingAhead();
+      ObjectFile *dispatch = nullptr;
+
+      /// Only the mutants that are going to run get a slot. The checks
+      /// follow the loop below: an alias runs unless the mutant it refers
+      /// to gets a result first.
+      std::vector<MutationPoint *> dispatchedPoints;
+      std::map<MutationPoint *, uint64_t> slots;
+      if (useSlots && !Cfg.isDryRun()) {
+        std::set<MutationPoint *> resolvedPoints;
+        for (auto mutationPoint : MPoints) {
+          if (!shard.contains(mutationPoint) ||
+              (sink && sink->isReported(*Result, *mutationPoint))) {
+            continue;
+          }
+          resolvedPoints.insert(mutationPoint);
+
+          ExecutionResult reused;
+          MutationPoint *aliasOf = equivalence.aliasOf(mutationPoint);
+          if (history.lookup(*Result, *mutationPoint, functionHash, reused) ||
+              equivalence.isEquivalent(mutationPoint) ||
+              (aliasOf && resolvedPoints.count(aliasOf))) {
+            continue;
+          }
+
+          dispatchedPoints.push_back(mutationPoint);
+          slots.insert(std::make_pair(mutationPoint, dispatchedPoints.size()));
+        }
+      }
+
       for (auto mutationPoint : MPoints) {
 
+        if (!shard.contains(mutationPoint)) {
+          continue;
+        }
+
+        if (sink && sink->isReported(*Result, *mutationPoint)) {
+          Logger::debug() << "-";
+          continue;
+        }
+
         Logger::debug() << ".";
 
+        auto mutantStart = steady_clock::now();
         ExecutionResult result;
+        MutationPoint *aliasOf = equivalence.aliasOf(mutationPoint);
         bool dryRun = Cfg.isDryRun();
+        bool skipped = true;
         if (dryRun) {
           result.status = DryRun;
           result.runningTime = ExecResult.runningTime * 10;
+        } else if (history.lookup(*Result, *mutationPoint, functionHash, result)) {
+          aliasOf = nullptr;
+          reusedResults++;
+        } else if (equivalence.isEquivalent(mutationPoint)) {
+          result.status = Equivalent;
+          result.exitStatus = 0;
+          result.runningTime = 0;
+        } else if (aliasOf && mutantResults.count(aliasOf)) {
+          result = mutantResults.at(aliasOf);
         } else {
-          ObjectFile *mutant = toolchain.cache().getObject(*mutationPoint);
-          if (mutant == nullptr) {
-            LLVMContext localContext;
-            auto clonedModule = mutationPoint->getOriginalModule()->clone(localContext);
-            mutationPoint->applyMutation(*clonedModule.get());
-
-            auto owningObject = toolchain.compiler().compileModule(*clonedModule.get());
+          aliasOf = nullptr;
+          skipped = false;
+          uint64_t slot = 0;
+          if (useSlots) {
+            if (dispatch == nullptr) {
+              dispatch = dispatchObject(testeeFunction, dispatchedPoints,
+                                        ExecResult.runningTime);
+              ObjectFiles.push_back(dispatch);
+
+              if (linkAhead) {
+                Runner.linkObjectFiles(ObjectFiles);
+              }
+            }
 
-            mutant = owningObject.getBinary();
-            toolchain.cache().putObject(std::move(owningObject), *mutationPoint);
+            assert(slots.count(mutationPoint) && "Mutant is missing in the object");
+            slot = slots.at(mutationPoint);
+          } else {
+            CodegenProfile profile = mutantCodegen.select(ExecResult.runningTime);
+            ObjectFile *mutant = toolchain.cache().getObject(*mutationPoint,
+                                                             profile,
+                                                             onDemand);
+            if (mutant == nullptr) {
+              TraceScope scope("compile mutant", "compile");
+              LLVMContext localContext;
+              MullModule *originalModule = mutationPoint->getOriginalModule();
+              auto clonedModule = originalModule->clone(localContext);
+              mutationPoint->applyMutation(*clonedModule.get());
+              if (onDemand) {
+                FunctionStubs::extractMutant(*clonedModule.get(),
+                                             testeeFunction,
+                                             originalModule->getIdentifierHash());
+              }
+
+              auto owningObject = compileMutants(*clonedModule.get(), profile);
+
+              mutant = owningObject.getBinary();
+              toolchain.cache().putObject(std::move(owningObject),
+                                          *mutationPoint,
+                                          profile,
+                                          onDemand);
+            }
+            ObjectFiles.push_back(mutant);
           }
-          ObjectFiles.push_back(mutant);
 
           const auto sandboxTimeout = std::max(30LL,
                                                ExecResult.runningTime * 10);
 
+          TraceScope execution("run mutant", "mutants");
           result = Sandbox->run([&]() {
-            for (std::string &dylibPath: Cfg.getDynamicLibrariesPaths()) {
-              sys::DynamicLibrary::LoadLibraryPermanently(dylibPath.c_str());
+            if (useSlots) {
+              mutantSlots.activate(testeeFunction, slot);
+            }
+
+            ExecutionStatus status;
+            if (linkAhead) {
+              std::vector<Test *> tests({ BorrowedTest });
+              status = Runner.runLinkedTests(tests);
+            } else {
+              status = Runner.runTest(BorrowedTest, ObjectFiles);
             }
-            ExecutionStatus status = Runner.runTest(BorrowedTest, ObjectFiles);
             assert(status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
             return status;
           }, sandboxTimeout);
+          execution.finish();
 
-          ObjectFiles.pop_back();
+          if (useSlots) {
+            /// Only matters when the mutant ran in this process
+            mutantSlots.deactivate(testeeFunction);
+          } else {
+            ObjectFiles.pop_back();
+          }
 
           assert(result.status != ExecutionStatus::Invalid &&
                  "Expect to see valid TestResult");
         }
 
+        if (equivalence.aliasesCount() != 0) {
+          mutantResults.insert(std::make_pair(mutationPoint, result));
+        }
+
         diagnostics->report(mutationPoint, result.status);
 
-        auto mutationResult = make_unique<MutationResult>(result, mutationPoint, testee->getDistance());
-        Result->addMutantResult(std::move(mutationResult));
+        auto mutationResult = make_unique<MutationResult>(result,
+                                                          mutationPoint,
+                                                          testee->getDistance(),
+                                                          aliasOf);
+        mutationResult->setFunctionHash(functionHash);
+        if (sink) {
+          TraceScope scope("report", "report");
+          sink->reportMutant(*Result, *mutationResult);
+        } else {
+          Result->addMutantResult(std::move(mutationResult));
+        }
+
+        auto mutantTime = steady_clock::now() - mutantStart;
+        progress.mutantFinished(progressTests[baselineIndex], result.status,
+                                duration_cast<milliseconds>(mutantTime).count(),
+                                skipped);
+      }
+
+      if (linkAhead && dispatch) {
+        Runner.unlinkObjectFiles();
       }
 
       Logger::debug() << "\n";
@@ -279,11 +626,152 @@ std::unique_ptr<Result> Driver::Run() {
     Results.push_back(std::move(Result));
   }
 
+  progress.finish();
+
+  if (history.size() != 0) {
+    Logger::debug() << "Driver::Run> reused " << reusedResults
+                    << " results of the previous run\n";
+  }
+
   std::unique_ptr<Result> result = make_unique<Result>(std::move(Results));
 
   return result;
 }
 
+void Driver::runBaseline(std::unique_ptr<Test> test,
+                         std::vector<BaselineRun> &baselineRuns) {
+  auto ObjectFiles = AllObjectFiles();
+
+  Logger::debug().indent(6)
+    << "Driver::Run> current test: "
+    << test->getTestName()
+    << "\n";
+
+  _callstack = stack<uint64_t>();
+  memset(_callTreeMapping, 0, functions.size() * sizeof(_callTreeMapping[0]));
+
+  TraceScope baseline("run test", "baseline");
+  ExecutionResult ExecResult = Sandbox->run([&]() {
+    return Runner.runTest(test.get(), ObjectFiles);
+  }, Cfg.getTimeout());
+  baseline.finish();
+
+  if (ExecResult.status != Passed) {
+    Logger::error() << "error: Test has failed: " << test->getTestName() << "\n";
+    Logger::error() << "status: " << ExecResult.getStatusAsString() << "\n";
+    Logger::error() << "exit code: " << ExecResult.exitStatus << "\n";
+    Logger::error() << "stdout: " << ExecResult.stdoutOutput << "\n";
+    Logger::error() << "stderr: " << ExecResult.stderrOutput << "\n";
+    return;
+  }
+
+  addBaselineRun(std::move(test), ExecResult, _callTreeMapping, baselineRuns);
+}
+
+bool Driver::runBaselineBatch(std::vector<std::unique_ptr<Test>> &tests,
+                              std::vector<BaselineRun> &baselineRuns) {
+  std::vector<Test *> borrowedTests;
+  std::vector<std::vector<uint64_t>> entryPoints;
+  for (auto &test : tests) {
+    borrowedTests.push_back(test.get());
+
+    std::vector<uint64_t> indices;
+    for (Function *entryPoint : test->entryPoints()) {
+      auto index = functionIndices.find(entryPoint);
+      if (index != functionIndices.end()) {
+        indices.push_back(index->second);
+      }
+    }
+    entryPoints.push_back(indices);
+  }
+
+  auto ObjectFiles = AllObjectFiles();
+
+  _callstack = stack<uint64_t>();
+  _baselineBatch->begin(entryPoints);
+
+  TraceScope baseline("run test batch", "baseline");
+  ExecutionResult batchResult = Sandbox->run([&]() {
+    return Runner.runTests(borrowedTests, ObjectFiles);
+  }, Cfg.getTimeout() * tests.size());
+  baseline.finish();
+
+  _baselineBatch->end();
+
+  /// Which test failed or crashed is not known,
+  /// the caller runs each of them on its own then
+  bool finished = batchResult.status == Passed;
+  for (size_t slot = 0; finished && slot < tests.size(); slot++) {
+    finished = _baselineBatch->hasFinished(slot);
+  }
+  if (!finished) {
+    Logger::debug().indent(6)
+      << "Driver::Run> batch status: " << batchResult.getStatusAsString()
+      << ", running the tests one by one\n";
+    return false;
+  }
+
+  /// The time spent outside of the tests themselves (linking, static
+  /// constructors, the framework) is paid again by every process that runs
+  /// a single test, as each mutant does: every test gets all of it
+  long long testsTime = 0;
+  for (size_t slot = 0; slot < tests.size(); slot++) {
+    testsTime += _baselineBatch->runningTimeMicroseconds(slot) / 1000;
+  }
+  long long overhead = std::max(0LL, batchResult.runningTime - testsTime);
+
+  for (size_t slot = 0; slot < tests.size(); slot++) {
+    /// The output of the batch cannot be told apart by test
+    ExecutionResult result = batchResult;
+    result.stdoutOutput.clear();
+    result.stderrOutput.clear();
+    result.runningTime =
+      _baselineBatch->runningTimeMicroseconds(slot) / 1000 + overhead;
+    addBaselineRun(std::move(tests[slot]), result,
+                   _baselineBatch->mapping(slot), baselineRuns);
+  }
+
+  return true;
+}
+
+void Driver::addBaselineRun(std::unique_ptr<Test> test,
+                            ExecutionResult &ExecResult,
+                            uint64_t *mapping,
+                            std::vector<BaselineRun> &baselineRuns) {
+  auto BorrowedTest = test.get();
+  auto Result = make_unique<TestResult>(ExecResult, std::move(test));
+
+  /// With lazily loaded bitcode only the functions the test reached get
+  /// their bodies read, everything downstream looks at these functions only
+  if (Cfg.shouldLoadBitcodeLazily()) {
+    TraceScope materialization("materialize functions", "baseline");
+    for (uint64_t index = 1; index < functions.size(); index++) {
+      if (mapping[index] != 0) {
+        MullModule::materialize(functions[index].function);
+      }
+    }
+  }
+
+  TraceScope callTreeScope("build call tree", "baseline");
+  std::unique_ptr<CallTree> callTree(dynamicCallTree.createCallTree(mapping));
+
+  auto subtrees = dynamicCallTree.extractTestSubtrees(callTree.get(), BorrowedTest);
+  auto testees = dynamicCallTree.createTestees(subtrees, BorrowedTest,
+                                               Cfg.getMaxDistance(), filter);
+
+  dynamicCallTree.cleanupCallTree(std::move(callTree));
+  callTreeScope.finish();
+  if (testees.empty()) {
+    Logger::error() << "error: Coult not find any testees: " << BorrowedTest->getTestName() << "\n";
+    return;
+  }
+
+  BaselineRun baselineRun;
+  baselineRun.result = std::move(Result);
+  baselineRun.testees = std::move(testees);
+  baselineRuns.push_back(std::move(baselineRun));
+}
+
 void Driver::prepareForExecution() {
   assert(_callTreeMapping == nullptr && "Called twice?");
   assert(functions.size() > 1 && "Functions must be filled in before this call");
@@ -349,6 +837,41 @@ void Driver::injectCallbacks(llvm::Function *function, uint64_t index) {
   }
 }
 
+ObjectFile *
+Driver::dispatchObject(llvm::Function *function,
+                       const std::vector<MutationPoint *> &mutationPoints,
+                       long long testTime) {
+  CodegenProfile profile = mutantCodegen.select(testTime);
+  ObjectFile *cached = toolchain.cache().getDispatchObject(mutationPoints,
+                                                          profile);
+  if (cached != nullptr) {
+    return cached;
+  }
+
+  TraceScope scope("compile mutants", "compile");
+  LLVMContext localContext;
+  MullModule *module = mutationPoints.front()->getOriginalModule();
+  auto clonedModule = module->clone(localContext);
+  mutantSlots.addDispatcher(*clonedModule.get(), function, mutationPoints);
+
+  auto owningObject = compileMutants(*clonedModule.get(), profile);
+  ObjectFile *object = owningObject.getBinary();
+  toolchain.cache().putDispatchObject(std::move(owningObject),
+                                      mutationPoints,
+                                      profile);
+  return object;
+}
+
+OwningBinary<ObjectFile> Driver::compileMutants(MullModule &module,
+                                                CodegenProfile profile) {
+  auto compileStart = steady_clock::now();
+  auto object = toolchain.compiler().compileModule(module, profile);
+  auto compileTime = duration_cast<milliseconds>(steady_clock::now() - compileStart);
+  mutantCodegen.addCompileTime(profile, compileTime.count());
+
+  return object;
+}
+
 std::vector<llvm::object::ObjectFile *> Driver::AllButOne(llvm::Module *One) {
   std::vector<llvm::object::ObjectFile *> Objects;
 
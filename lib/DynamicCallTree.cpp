@@ -68,6 +68,10 @@ void DynamicCallTree::prepare(uint64_t *m) {
 }
 
 std::unique_ptr<CallTree> DynamicCallTree::createCallTree() {
+  return createCallTree(mapping);
+}
+
+std::unique_ptr<CallTree> DynamicCallTree::createCallTree(uint64_t *mapping) {
   assert(mapping != nullptr);
   assert(mapping[0] == 0);
   assert(!functions.empty());
@@ -2,6 +2,7 @@
 
 #include "Logger.h"
 #include "TestResult.h"
+#include "Tracer.h"
 
 #include <errno.h>
 #include <chrono>
@@ -98,6 +99,7 @@ mull::ForkProcessSandbox::run(std::function<ExecutionStatus (void)> function,
     int status = 0;
     pid_t pid = 0;
     while ( (pid = waitpid(workerPID, &status, 0)) == -1 ) {}
+    Tracer::collectChildEvents();
 
     auto elapsed = high_resolution_clock::now() - start;
     ExecutionResult result;
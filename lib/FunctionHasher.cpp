@@ -0,0 +1,316 @@
+#include "FunctionHasher.h"
+
+#include "Context.h"
+#include "Logger.h"
+#include "MullModule.h"
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/CallSite.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+static std::string md5(StringRef data) {
+  MD5 hasher;
+  hasher.update(data);
+
+  MD5::MD5Result hash;
+  hasher.final(hash);
+
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str();
+}
+
+/// Local values are named by their position in the function, so that
+/// neither the slot numbers nor the names picked by the frontend matter.
+static void describeOperand(raw_ostream &out,
+                            const Value *operand,
+                            const DenseMap<const Value *, unsigned> &locals) {
+  auto local = locals.find(operand);
+  if (local != locals.end()) {
+    out << '%' << local->second;
+    return;
+  }
+
+  if (isa<GlobalValue>(operand)) {
+    out << '@' << operand->getName();
+    return;
+  }
+
+  if (isa<MetadataAsValue>(operand)) {
+    out << '!';
+    return;
+  }
+
+  operand->printAsOperand(out, true);
+}
+
+static void describeAttributes(raw_ostream &out, AttributeSet attributes) {
+  for (unsigned slot = 0; slot < attributes.getNumSlots(); slot++) {
+    unsigned index = attributes.getSlotIndex(slot);
+    out << ' ' << index << ':' << attributes.getAsString(index);
+  }
+}
+
+/// The globals and functions a function refers to, in the order they are met
+namespace {
+struct References {
+  std::vector<const GlobalVariable *> globals;
+  std::vector<Function *> functions;
+  SmallPtrSet<const Constant *, 16> visited;
+};
+}
+
+/// Follows the initializers of globals: a function that only loads a
+/// pointer from a table still depends on the functions in that table.
+static void collectReferences(const Constant *constant,
+                              References &references) {
+  if (!references.visited.insert(constant).second) {
+    return;
+  }
+
+  if (auto function = dyn_cast<Function>(constant)) {
+    references.functions.push_back(const_cast<Function *>(function));
+    return;
+  }
+
+  if (auto global = dyn_cast<GlobalVariable>(constant)) {
+    references.globals.push_back(global);
+    if (global->hasInitializer()) {
+      collectReferences(global->getInitializer(), references);
+    }
+    return;
+  }
+
+  if (auto alias = dyn_cast<GlobalAlias>(constant)) {
+    collectReferences(alias->getAliasee(), references);
+    return;
+  }
+
+  for (const Use &operand : constant->operands()) {
+    if (auto operandConstant = dyn_cast<Constant>(operand.get())) {
+      collectReferences(operandConstant, references);
+    }
+  }
+}
+
+static References findReferences(Function &function) {
+  References references;
+  for (BasicBlock &block : function) {
+    for (Instruction &instruction : block) {
+      for (const Use &operand : instruction.operands()) {
+        if (auto constant = dyn_cast<Constant>(operand.get())) {
+          collectReferences(constant, references);
+        }
+      }
+    }
+  }
+  return references;
+}
+
+std::string FunctionHasher::hashFunctionBody(Function &function) {
+  DenseMap<const Value *, unsigned> locals;
+  for (Argument &argument : function.args()) {
+    locals.insert(std::make_pair(&argument, locals.size()));
+  }
+  for (BasicBlock &block : function) {
+    locals.insert(std::make_pair(&block, locals.size()));
+    for (Instruction &instruction : block) {
+      locals.insert(std::make_pair(&instruction, locals.size()));
+    }
+  }
+
+  std::string body;
+  raw_string_ostream out(body);
+  out << *function.getFunctionType() << ' ' << function.getCallingConv();
+  describeAttributes(out, function.getAttributes());
+  out << '\n';
+
+  for (BasicBlock &block : function) {
+    out << "%" << locals[&block] << ":\n";
+    for (Instruction &instruction : block) {
+      if (isa<DbgInfoIntrinsic>(instruction)) {
+        continue;
+      }
+
+      out << '%' << locals[&instruction] << " = "
+          << instruction.getOpcodeName() << ' '
+          << instruction.getRawSubclassOptionalData() << ' '
+          << *instruction.getType();
+
+      if (auto cmp = dyn_cast<CmpInst>(&instruction)) {
+        out << ' ' << cmp->getPredicate();
+      }
+
+      for (const Use &operand : instruction.operands()) {
+        out << ' ';
+        describeOperand(out, operand.get(), locals);
+      }
+
+      /// The incoming blocks are not operands of a phi
+      if (auto phi = dyn_cast<PHINode>(&instruction)) {
+        for (unsigned i = 0; i < phi->getNumIncomingValues(); i++) {
+          out << " [";
+          describeOperand(out, phi->getIncomingBlock(i), locals);
+          out << ']';
+        }
+      }
+
+      CallSite callSite(&instruction);
+      if (callSite) {
+        out << ' ' << callSite.getCallingConv();
+        describeAttributes(out, callSite.getAttributes());
+      }
+
+      out << '\n';
+    }
+  }
+
+  /// Globals are referred to by name, their initial values are part of
+  /// the body of every function that reads them
+  for (const GlobalVariable *global : findReferences(function).globals) {
+    out << '@' << global->getName() << ' ' << global->isConstant();
+    if (global->hasInitializer()) {
+      out << " = ";
+      global->getInitializer()->printAsOperand(out, true);
+    }
+    out << '\n';
+  }
+
+  return md5(out.str());
+}
+
+/// Besides the direct callees, the functions whose addresses the function
+/// takes are the only ones it can call through a pointer it did not get
+/// from its caller
+static std::vector<Function *> findCallees(Context &context,
+                                           Function &function) {
+  std::vector<Function *> functionCallees;
+  for (Function *callee : findReferences(function).functions) {
+    if (callee->isDeclaration()) {
+      callee = context.lookupDefinedFunction(callee->getName());
+    }
+
+    if (callee && callee != &function) {
+      functionCallees.push_back(callee);
+    }
+  }
+  return functionCallees;
+}
+
+void FunctionHasher::computeHashes(Context &context, int maxDistance) {
+  DenseMap<Function *, std::string> bodies;
+  DenseMap<Function *, std::vector<Function *>> callees;
+
+  for (auto &module : context.getModules()) {
+    for (Function &function : *module->getModule()) {
+      if (function.isDeclaration()) {
+        continue;
+      }
+
+      bodies.insert(std::make_pair(&function, hashFunctionBody(function)));
+      callees[&function] = findCallees(context, function);
+    }
+  }
+
+  combineHashes(bodies, callees, maxDistance);
+}
+
+void FunctionHasher::computeHashes(Context &context, int maxDistance,
+                                   const std::vector<Function *> &roots) {
+  DenseMap<Function *, std::string> bodies;
+  DenseMap<Function *, std::vector<Function *>> callees;
+
+  /// Functions further than maxDistance calls from every root cannot change
+  /// the hash of a root, so their bodies are never read
+  std::vector<Function *> pending(roots);
+  for (int distance = 0; distance <= maxDistance && !pending.empty();
+       distance++) {
+    std::vector<Function *> next;
+
+    for (Function *function : pending) {
+      if (bodies.count(function)) {
+        continue;
+      }
+
+      MullModule::materialize(function);
+      if (function->isDeclaration()) {
+        continue;
+      }
+
+      bodies.insert(std::make_pair(function, hashFunctionBody(*function)));
+      callees[function] = findCallees(context, *function);
+      next.insert(next.end(),
+                  callees[function].begin(), callees[function].end());
+    }
+
+    pending = std::move(next);
+  }
+
+  combineHashes(bodies, callees, maxDistance);
+}
+
+void FunctionHasher::combineHashes(
+    const DenseMap<Function *, std::string> &bodies,
+    const DenseMap<Function *, std::vector<Function *>> &callees,
+    int maxDistance) {
+  /// Each round folds in callees one call further away. Functions that do
+  /// not reach a cycle stop changing once their deepest callee is covered.
+  for (auto &body : bodies) {
+    hashes[body.first] = md5(body.second);
+  }
+
+  for (int distance = 1; distance <= maxDistance; distance++) {
+    DenseMap<Function *, std::string> nextHashes;
+    bool changed = false;
+
+    for (auto &body : bodies) {
+      std::vector<std::string> calleeHashes;
+      for (Function *callee : callees.find(body.first)->second) {
+        calleeHashes.push_back(hashOf(callee));
+      }
+      std::sort(calleeHashes.begin(), calleeHashes.end());
+
+      std::string combined = body.second;
+      for (std::string &calleeHash : calleeHashes) {
+        combined += calleeHash;
+      }
+
+      std::string hash = md5(combined);
+      changed = changed || hash != hashes[body.first];
+      nextHashes[body.first] = hash;
+    }
+
+    hashes = std::move(nextHashes);
+
+    if (!changed) {
+      break;
+    }
+  }
+
+  Logger::debug() << "FunctionHasher> hashed " << hashes.size()
+                  << " functions\n";
+}
+
+std::string FunctionHasher::hashOf(Function *function) const {
+  auto hash = hashes.find(function);
+  if (hash == hashes.end()) {
+    return std::string();
+  }
+  return hash->second;
+}
@@ -0,0 +1,237 @@
+#include "FunctionStubs.h"
+
+#include "MullModule.h"
+#include "MutantSlots.h"
+#include "SymbolCache.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Mangler.h>
+#include <llvm/IR/Module.h>
+
+using namespace mull;
+using namespace llvm;
+
+bool FunctionStubs::canStub(Function &function) {
+  return !function.isDeclaration() &&
+    function.hasExternalLinkage() &&
+    MutantSlots::canDispatch(function);
+}
+
+/// The runners look the static constructors up by their names in the
+/// modules, and a mutant never refers to them
+static std::set<GlobalValue *> staticConstructors(Module &module) {
+  std::set<GlobalValue *> constructors;
+
+  for (const char *name : { "llvm.global_ctors", "llvm.global_dtors" }) {
+    GlobalVariable *list = module.getNamedGlobal(name);
+    if (list == nullptr || !list->hasInitializer()) {
+      continue;
+    }
+
+    auto entries = dyn_cast<ConstantArray>(list->getInitializer());
+    if (entries == nullptr) {
+      continue;
+    }
+
+    for (Value *entry : entries->operands()) {
+      auto fields = dyn_cast<ConstantStruct>(entry);
+      if (fields && fields->getNumOperands() > 1) {
+        Value *constructor = fields->getOperand(1)->stripPointerCasts();
+        if (auto function = dyn_cast<Function>(constructor)) {
+          constructors.insert(function);
+        }
+      }
+    }
+  }
+
+  return constructors;
+}
+
+static void exposeSymbol(GlobalValue &value,
+                         const std::string &suffix,
+                         const std::set<GlobalValue *> &constructors,
+                         uint64_t &unnamedCount) {
+  if (!value.hasLocalLinkage() || value.getName().startswith("llvm.") ||
+      constructors.count(&value)) {
+    return;
+  }
+
+  /// Both sides walk the same bitcode in the same order,
+  /// so the unnamed symbols get the same numbers
+  if (value.hasName()) {
+    value.setName(value.getName() + suffix);
+  } else {
+    value.setName("mull_unnamed_" + Twine(unnamedCount++) + suffix);
+  }
+  value.setLinkage(GlobalValue::ExternalLinkage);
+  value.setVisibility(GlobalValue::DefaultVisibility);
+}
+
+void FunctionStubs::exposeLocalSymbols(Module &module, uint64_t moduleHash) {
+  std::string suffix = ".mull_" + utohexstr(moduleHash);
+  std::set<GlobalValue *> constructors = staticConstructors(module);
+  uint64_t unnamedCount = 0;
+
+  for (Function &function : module.functions()) {
+    exposeSymbol(function, suffix, constructors, unnamedCount);
+  }
+  for (GlobalVariable &global : module.globals()) {
+    exposeSymbol(global, suffix, constructors, unnamedCount);
+  }
+  for (GlobalAlias &alias : module.aliases()) {
+    exposeSymbol(alias, suffix, constructors, unnamedCount);
+  }
+}
+
+/// Ends the block with a call of the callee that passes all the arguments
+/// of the stub through
+static void forwardCall(Function *stub, Value *callee, Function *original,
+                        BasicBlock *block) {
+  std::vector<Value *> arguments;
+  for (Argument &argument : stub->args()) {
+    arguments.push_back(&argument);
+  }
+
+  IRBuilder<> builder(block);
+  CallInst *call = builder.CreateCall(callee, arguments);
+  call->setTailCall();
+  call->setCallingConv(original->getCallingConv());
+  call->setAttributes(original->getAttributes());
+
+  if (stub->getReturnType()->isVoidTy()) {
+    builder.CreateRetVoid();
+  } else {
+    builder.CreateRet(call);
+  }
+}
+
+void FunctionStubs::addStub(Function *original, Function *function) {
+  assert(canStub(*function) && "The function cannot be stubbed");
+
+  Module *module = function->getParent();
+  LLVMContext &context = module->getContext();
+
+  Function *stub = Function::Create(function->getFunctionType(),
+                                    function->getLinkage(),
+                                    "",
+                                    module);
+  stub->copyAttributesFrom(function);
+  stub->setComdat(function->getComdat());
+
+  function->replaceAllUsesWith(stub);
+  stub->takeName(function);
+  function->setName(stub->getName() + ".mull_original");
+  function->setLinkage(GlobalValue::InternalLinkage);
+  function->setVisibility(GlobalValue::DefaultVisibility);
+  function->setComdat(nullptr);
+
+  /// Declared only, a mutant object brings the definition
+  GlobalVariable *slot = new GlobalVariable(*module,
+                                            function->getType(),
+                                            false,
+                                            GlobalValue::ExternalLinkage,
+                                            nullptr,
+                                            stub->getName() + ".mull_slot");
+
+  BasicBlock *entry = BasicBlock::Create(context, "entry", stub);
+  BasicBlock *originalBlock = BasicBlock::Create(context, "original", stub);
+  BasicBlock *mutantBlock = BasicBlock::Create(context, "mutant", stub);
+
+  IRBuilder<> builder(entry);
+  Value *mutant = builder.CreateLoad(slot, "mutant");
+  builder.CreateCondBr(builder.CreateIsNull(mutant), originalBlock, mutantBlock);
+  forwardCall(stub, function, function, originalBlock);
+  forwardCall(stub, mutant, function, mutantBlock);
+
+  SmallString<128> slotName;
+  Mangler::getNameWithPrefix(slotName, slot->getName(), module->getDataLayout());
+  SymbolCache::define(slotName.str(), (uint64_t)&emptySlot);
+
+  stubbedFunctions.insert(original);
+}
+
+bool FunctionStubs::hasStub(Function *original) const {
+  return stubbedFunctions.count(original) != 0;
+}
+
+void FunctionStubs::extractMutant(MullModule &clone,
+                                  Function *function,
+                                  uint64_t moduleHash) {
+  Module *module = clone.getModule();
+  Function *mutant = module->getFunction(function->getName());
+  assert(mutant && !mutant->isDeclaration() &&
+         "The clone must contain the function");
+
+  exposeLocalSymbols(*module, moduleHash);
+  std::string stubName = mutant->getName();
+
+  /// The instrumented object runs the constructors already
+  for (const char *name : { "llvm.global_ctors", "llvm.global_dtors",
+                            "llvm.used", "llvm.compiler.used" }) {
+    if (GlobalVariable *global = module->getNamedGlobal(name)) {
+      global->eraseFromParent();
+    }
+  }
+
+  /// Aliases cannot be declared, they give way to declarations
+  /// of the same name
+  for (auto it = module->alias_begin(); it != module->alias_end();) {
+    GlobalAlias &alias = *it++;
+    GlobalValue *declaration = nullptr;
+    if (auto functionType = dyn_cast<FunctionType>(alias.getValueType())) {
+      declaration = Function::Create(functionType,
+                                     GlobalValue::ExternalLinkage,
+                                     "",
+                                     module);
+    } else {
+      declaration = new GlobalVariable(*module,
+                                       alias.getValueType(),
+                                       false,
+                                       GlobalValue::ExternalLinkage,
+                                       nullptr,
+                                       "");
+    }
+    alias.replaceAllUsesWith(ConstantExpr::getBitCast(declaration,
+                                                      alias.getType()));
+    declaration->takeName(&alias);
+    alias.eraseFromParent();
+  }
+
+  for (Function &other : module->functions()) {
+    if (&other != mutant && !other.isDeclaration()) {
+      other.deleteBody();
+    }
+    other.setComdat(nullptr);
+  }
+
+  for (GlobalVariable &global : module->globals()) {
+    if (global.getName().startswith("llvm.")) {
+      continue;
+    }
+    if (!global.isDeclaration()) {
+      global.setInitializer(nullptr);
+      global.setLinkage(GlobalValue::ExternalLinkage);
+    }
+    global.setComdat(nullptr);
+  }
+
+  mutant->setName(stubName + ".mull_mutant");
+  mutant->setLinkage(GlobalValue::ExternalLinkage);
+  mutant->setVisibility(GlobalValue::DefaultVisibility);
+
+  new GlobalVariable(*module,
+                     mutant->getType(),
+                     true,
+                     GlobalValue::ExternalLinkage,
+                     mutant,
+                     stubName + ".mull_slot");
+
+  /// The debug info describes the whole module
+  StripDebugInfo(*module);
+}
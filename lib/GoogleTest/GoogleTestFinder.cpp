@@ -3,6 +3,7 @@
 #include "Context.h"
 #include "Filter.h"
 #include "Logger.h"
+#include "MullModule.h"
 
 #include <llvm/IR/CallSite.h>
 #include <llvm/IR/Constants.h>
@@ -12,10 +13,13 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Support/Debug.h>
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include "GoogleTest/GoogleTest_Test.h"
 
+#include <algorithm>
+#include <cctype>
 #include <vector>
 
 using namespace mull;
@@ -54,165 +58,261 @@ using namespace llvm;
 /// Note: except of Typed and Value Prametrized Tests
 ///
 
+GoogleTestFinder::GoogleTestFinder(unsigned workers) : workers(workers) {}
+
+static const StringRef TestBodySuffix("8TestBodyEv");
+
+/// TestBody functions are mangled as nested names, e.g.
+///
+///   _ZN16Hello_world_Test8TestBodyEv
+///   _ZN9namespace16Hello_world_Test8TestBodyEv
+///
+/// The component right before TestBody is the class name of the test.
+/// Returns an empty string for names that do not follow this pattern.
+static StringRef testClassName(StringRef name) {
+  if (!name.startswith("_ZN") || !name.endswith(TestBodySuffix)) {
+    return StringRef();
+  }
+
+  StringRef components = name.drop_front(3).drop_back(TestBodySuffix.size());
+  StringRef lastComponent;
+  while (!components.empty()) {
+    size_t digits = 0;
+    while (digits < components.size() && isdigit(components[digits])) {
+      digits++;
+    }
+
+    size_t length = 0;
+    if (components.substr(0, digits).getAsInteger(10, length) ||
+        digits + length > components.size()) {
+      return StringRef();
+    }
+    lastComponent = components.substr(digits, length);
+    components = components.drop_front(digits + length);
+  }
+
+  return lastComponent;
+}
+
+std::map<std::string, Function *>
+GoogleTestFinder::indexTestBodies(Module &module) {
+  std::map<std::string, Function *> index;
+  for (auto &function : module.getFunctionList()) {
+    StringRef className = testClassName(function.getName());
+    if (!className.empty() && className.endswith("_Test")) {
+      index.insert(std::make_pair(className.str(), &function));
+    }
+  }
+  return index;
+}
+
 std::vector<std::unique_ptr<Test>> GoogleTestFinder::findTests(Context &context,
                                                                Filter &filter) {
+  /// The same constructors are run before each test
+  std::vector<Function *> constructors = context.getStaticConstructors();
+
+  /// The tests are registered by the static constructors, with lazily
+  /// loaded bitcode their bodies and the bodies they call are read up front
+  for (Function *constructor : constructors) {
+    MullModule::materialize(constructor);
+    for (Instruction &instruction : instructions(constructor)) {
+      CallSite callSite(&instruction);
+      if (callSite && callSite.getCalledFunction()) {
+        MullModule::materialize(callSite.getCalledFunction());
+      }
+    }
+  }
+
+  auto &modules = context.getModules();
+  std::vector<std::vector<std::unique_ptr<Test>>> testsOfModules(modules.size());
+
+  {
+    ThreadPool pool(std::max(1u, workers));
+    for (size_t index = 0; index < modules.size(); index++) {
+      Module &module = *modules[index]->getModule();
+      pool.async([this, &module, &filter, &constructors, &testsOfModules, index]() {
+        testsOfModules[index] = findTestsInModule(module, filter, constructors);
+      });
+    }
+    pool.wait();
+  }
+
   std::vector<std::unique_ptr<Test>> tests;
+  for (auto &testsOfModule : testsOfModules) {
+    for (auto &test : testsOfModule) {
+      tests.push_back(std::move(test));
+    }
+  }
 
-  auto testInfoTypeName = StringRef("class.testing::TestInfo");
+  return tests;
+}
 
-  for (auto &currentModule : context.getModules()) {
-    for (auto &globalValue : currentModule->getModule()->getGlobalList()) {
-      Type *globalValueType = globalValue.getValueType();
-      if (globalValueType->getTypeID() != Type::PointerTyID) {
-        continue;
-      }
+std::vector<std::unique_ptr<Test>>
+GoogleTestFinder::findTestsInModule(Module &module,
+                                    Filter &filter,
+                                    const std::vector<Function *> &constructors) {
+  std::vector<std::unique_ptr<Test>> tests;
 
-      /// Downgrading from LLVM 4.0 to 3.9:
-      /// in 4.0 the pointer type is used instead of sequential type.
-      // - Type *globalType = Ty->getPointerElementType();
-      // - if (!globalType) {
-      // -   continue;
-      // - }
-      // - StructType *STy = dyn_cast<StructType>(globalType);
-      Type *sequentialType = globalValueType->getSequentialElementType();
-      if (!sequentialType) {
-        continue;
-      }
+  auto testInfoTypeName = StringRef("class.testing::TestInfo");
 
-      StructType *structType = dyn_cast<StructType>(sequentialType);
-      if (!structType) {
-        continue;
-      }
+  /// Looking up TestBody functions by name instead of scanning all the
+  /// functions of the module for each test
+  std::map<std::string, Function *> testBodies = indexTestBodies(module);
 
-      /// If two modules contain the same type, then when second modules is loaded
-      /// the typename is changed a bit, e.g.:
-      ///
-      ///   class.testing::TestInfo     // type from first module
-      ///   class.testing::TestInfo.25  // type from second module
-      ///
-      /// Hence we cannot just compare string, and rather should
-      /// compare the beginning of the typename
-
-      if (!structType->getName().startswith(testInfoTypeName)) {
-        continue;
-      }
+  for (auto &globalValue : module.getGlobalList()) {
+    Type *globalValueType = globalValue.getValueType();
+    if (globalValueType->getTypeID() != Type::PointerTyID) {
+      continue;
+    }
 
-      /// Normally the globalValue has only one usage, ut LLVM could add
-      /// intrinsics such as @llvm.invariant.start
-      /// We need to find a user that is a store instruction, which is
-      /// a part of initialization function
-      /// It looks like this:
-      ///
-      ///   store %"class.testing::TestInfo"* %call2, %"class.testing::TestInfo"** @_ZN16Hello_world_Test10test_info_E
-      ///
-      /// From here we need to extract actual user, which is a `store` instruction
-      /// The `store` instruction uses variable `%call2`, which is created
-      /// from the following code:
-      ///
-      ///   %call2 = call %"class.testing::TestInfo"* @_ZN7testing8internal23MakeAndRegisterTestInfoEPKcS2_S2_S2_PKvPFvvES6_PNS0_15TestFactoryBaseE(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str, i32 0, i32 0), i8* getelementptr inbounds ([4 x i8], [4 x i8]* @.str.1, i32 0, i32 0), i8* null, i8* null, i8* %call, void ()* @_ZN7testing4Test13SetUpTestCaseEv, void ()* @_ZN7testing4Test16TearDownTestCaseEv, %"class.testing::internal::TestFactoryBase"* %1)
-      ///
-      /// Which can be roughly simplified to the following pseudo-code:
-      ///
-      ///   testInfo = MakeAndRegisterTestInfo("Test Suite Name",
-      ///                                      "Test Case Name",
-      ///                                      setUpFunctionPtr,
-      ///                                      tearDownFunctionPtr,
-      ///                                      some_other_ignored_parameters)
-      ///
-      /// Where `testInfo` is exactly the `%call2` from above.
-      /// From the `MakeAndRegisterTestInfo` we need to extract test suite
-      /// and test case names. Having those in place it's possible to provide
-      /// correct filter for GoogleTest framework
-      ///
-      /// Putting lots of assertions to check the hardway whether
-      /// my assumptions are correct or not
-
-      StoreInst *storeInstruction = nullptr;
-      for (auto userIterator = globalValue.user_begin();
-           userIterator != globalValue.user_end();
-           userIterator++) {
-        auto user = *userIterator;
-        if (isa<StoreInst>(user)) {
-          storeInstruction = dyn_cast<StoreInst>(user);
-          break;
-        }
-      }
+    /// Downgrading from LLVM 4.0 to 3.9:
+    /// in 4.0 the pointer type is used instead of sequential type.
+    // - Type *globalType = Ty->getPointerElementType();
+    // - if (!globalType) {
+    // -   continue;
+    // - }
+    // - StructType *STy = dyn_cast<StructType>(globalType);
+    Type *sequentialType = globalValueType->getSequentialElementType();
+    if (!sequentialType) {
+      continue;
+    }
+
+    StructType *structType = dyn_cast<StructType>(sequentialType);
+    if (!structType) {
+      continue;
+    }
 
-      assert(storeInstruction &&
-             "The Global should be used within a store instruction");
-      auto valueOperand = storeInstruction->getValueOperand();
+    /// If two modules contain the same type, then when second modules is loaded
+    /// the typename is changed a bit, e.g.:
+    ///
+    ///   class.testing::TestInfo     // type from first module
+    ///   class.testing::TestInfo.25  // type from second module
+    ///
+    /// Hence we cannot just compare string, and rather should
+    /// compare the beginning of the typename
+
+    if (!structType->getName().startswith(testInfoTypeName)) {
+      continue;
+    }
 
-      auto callSite = CallSite(valueOperand);
-      assert((callSite.isCall() || callSite.isInvoke()) &&
-             "Store should be using call to MakeAndRegisterTestInfo");
+    /// Normally the globalValue has only one usage, ut LLVM could add
+    /// intrinsics such as @llvm.invariant.start
+    /// We need to find a user that is a store instruction, which is
+    /// a part of initialization function
+    /// It looks like this:
+    ///
+    ///   store %"class.testing::TestInfo"* %call2, %"class.testing::TestInfo"** @_ZN16Hello_world_Test10test_info_E
+    ///
+    /// From here we need to extract actual user, which is a `store` instruction
+    /// The `store` instruction uses variable `%call2`, which is created
+    /// from the following code:
+    ///
+    ///   %call2 = call %"class.testing::TestInfo"* @_ZN7testing8internal23MakeAndRegisterTestInfoEPKcS2_S2_S2_PKvPFvvES6_PNS0_15TestFactoryBaseE(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str, i32 0, i32 0), i8* getelementptr inbounds ([4 x i8], [4 x i8]* @.str.1, i32 0, i32 0), i8* null, i8* null, i8* %call, void ()* @_ZN7testing4Test13SetUpTestCaseEv, void ()* @_ZN7testing4Test16TearDownTestCaseEv, %"class.testing::internal::TestFactoryBase"* %1)
+    ///
+    /// Which can be roughly simplified to the following pseudo-code:
+    ///
+    ///   testInfo = MakeAndRegisterTestInfo("Test Suite Name",
+    ///                                      "Test Case Name",
+    ///                                      setUpFunctionPtr,
+    ///                                      tearDownFunctionPtr,
+    ///                                      some_other_ignored_parameters)
+    ///
+    /// Where `testInfo` is exactly the `%call2` from above.
+    /// From the `MakeAndRegisterTestInfo` we need to extract test suite
+    /// and test case names. Having those in place it's possible to provide
+    /// correct filter for GoogleTest framework
+    ///
+    /// Putting lots of assertions to check the hardway whether
+    /// my assumptions are correct or not
+
+    StoreInst *storeInstruction = nullptr;
+    for (auto userIterator = globalValue.user_begin();
+         userIterator != globalValue.user_end();
+         userIterator++) {
+      auto user = *userIterator;
+      if (isa<StoreInst>(user)) {
+        storeInstruction = dyn_cast<StoreInst>(user);
+        break;
+      }
+    }
 
-      /// Once we have the CallInstruction we can extract Test Suite Name
-      /// and Test Case Name
-      /// To extract them we need climb to the top, i.e.:
-      ///
-      ///   i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str, i32 0, i32 0)
-      ///   i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str1, i32 0, i32 0)
+    assert(storeInstruction &&
+           "The Global should be used within a store instruction");
+    auto valueOperand = storeInstruction->getValueOperand();
 
-      auto testSuiteNameConstRef = dyn_cast<ConstantExpr>(callSite->getOperand(0));
-      assert(testSuiteNameConstRef);
+    auto callSite = CallSite(valueOperand);
+    assert((callSite.isCall() || callSite.isInvoke()) &&
+           "Store should be using call to MakeAndRegisterTestInfo");
 
-      auto testCaseNameConstRef = dyn_cast<ConstantExpr>(callSite->getOperand(1));
-      assert(testCaseNameConstRef);
+    /// Once we have the CallInstruction we can extract Test Suite Name
+    /// and Test Case Name
+    /// To extract them we need climb to the top, i.e.:
+    ///
+    ///   i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str, i32 0, i32 0)
+    ///   i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str1, i32 0, i32 0)
 
-      ///   @.str = private unnamed_addr constant [6 x i8] c"Hello\00", align 1
-      ///   @.str = private unnamed_addr constant [6 x i8] c"world\00", align 1
+    auto testSuiteNameConstRef = dyn_cast<ConstantExpr>(callSite->getOperand(0));
+    assert(testSuiteNameConstRef);
 
-      auto testSuiteNameConst = dyn_cast<GlobalValue>(testSuiteNameConstRef->getOperand(0));
-      assert(testSuiteNameConst);
+    auto testCaseNameConstRef = dyn_cast<ConstantExpr>(callSite->getOperand(1));
+    assert(testCaseNameConstRef);
 
-      auto testCaseNameConst = dyn_cast<GlobalValue>(testCaseNameConstRef->getOperand(0));
-      assert(testCaseNameConst);
+    ///   @.str = private unnamed_addr constant [6 x i8] c"Hello\00", align 1
+    ///   @.str = private unnamed_addr constant [6 x i8] c"world\00", align 1
 
-      ///   [6 x i8] c"Hello\00"
-      ///   [6 x i8] c"world\00"
+    auto testSuiteNameConst = dyn_cast<GlobalValue>(testSuiteNameConstRef->getOperand(0));
+    assert(testSuiteNameConst);
 
-      auto testSuiteNameConstArray = dyn_cast<ConstantDataArray>(testSuiteNameConst->getOperand(0));
-      assert(testSuiteNameConstArray);
+    auto testCaseNameConst = dyn_cast<GlobalValue>(testCaseNameConstRef->getOperand(0));
+    assert(testCaseNameConst);
 
-      auto testCaseNameConstArray = dyn_cast<ConstantDataArray>(testCaseNameConst->getOperand(0));
-      assert(testCaseNameConstArray);
+    ///   [6 x i8] c"Hello\00"
+    ///   [6 x i8] c"world\00"
 
-      ///   "Hello"
-      ///   "world"
+    auto testSuiteNameConstArray = dyn_cast<ConstantDataArray>(testSuiteNameConst->getOperand(0));
+    assert(testSuiteNameConstArray);
 
-      std::string testSuiteName = testSuiteNameConstArray->getRawDataValues().rtrim('\0').str();
-      std::string testCaseName = testCaseNameConstArray->getRawDataValues().rtrim('\0').str();
+    auto testCaseNameConstArray = dyn_cast<ConstantDataArray>(testCaseNameConst->getOperand(0));
+    assert(testCaseNameConstArray);
 
-      /// Once we've got the Name of a Test Suite and the name of a Test Case
-      /// We can construct the name of a Test
-      const std::string testName = testSuiteName + "." + testCaseName;
-      if (filter.shouldSkipTest(testName)) {
-        continue;
-      }
+    ///   "Hello"
+    ///   "world"
 
-      /// And the part of Test Body function name
-      std::string testBodyFunctionName = testSuiteName + "_" + testCaseName + "_Test8TestBodyEv";
-      StringRef testBodyFunctionNameRef(testBodyFunctionName);
+    std::string testSuiteName = testSuiteNameConstArray->getRawDataValues().rtrim('\0').str();
+    std::string testCaseName = testCaseNameConstArray->getRawDataValues().rtrim('\0').str();
 
-      /// Using the TestBodyFunctionName we could find the function
-      /// and finish creating the GoogleTest_Test object
+    /// Once we've got the Name of a Test Suite and the name of a Test Case
+    /// We can construct the name of a Test
+    const std::string testName = testSuiteName + "." + testCaseName;
+    if (filter.shouldSkipTest(testName)) {
+      continue;
+    }
 
-      Function *testBodyFunction = nullptr;
-      for (auto &func : currentModule->getModule()->getFunctionList()) {
-        auto foundPosition = func.getName().rfind(testBodyFunctionNameRef);
-        if (foundPosition != StringRef::npos) {
+    /// And the class name of the test, which is a part of the name of
+    /// the TestBody function. Using it we could find the function
+    /// and finish creating the GoogleTest_Test object
+    std::string testClassName = testSuiteName + "_" + testCaseName + "_Test";
+
+    Function *testBodyFunction = nullptr;
+    auto testBody = testBodies.find(testClassName);
+    if (testBody != testBodies.end()) {
+      testBodyFunction = testBody->second;
+    } else {
+      /// Unusual mangling, falling back to the search by name
+      std::string testBodyFunctionName = testClassName + TestBodySuffix.str();
+      for (auto &func : module.getFunctionList()) {
+        if (func.getName().rfind(testBodyFunctionName) != StringRef::npos) {
           testBodyFunction = &func;
           break;
         }
       }
-
-      assert(testBodyFunction && "Cannot find the TestBody function for the Test");
-
-      tests.emplace_back(make_unique<GoogleTest_Test>(testName,
-                                                      testBodyFunction,
-                                                      context.getStaticConstructors()));
     }
 
+    assert(testBodyFunction && "Cannot find the TestBody function for the Test");
+
+    tests.emplace_back(make_unique<GoogleTest_Test>(testName,
+                                                    testBodyFunction,
+                                                    constructors));
   }
 
   return tests;
@@ -2,9 +2,10 @@
 
 #include "GoogleTest/GoogleTest_Test.h"
 #include "Mangler.h"
+#include "Tracer.h"
+#include "SymbolCache.h"
 
 #include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
-#include <llvm/ExecutionEngine/SectionMemoryManager.h>
 
 using namespace mull;
 using namespace llvm;
@@ -25,7 +26,7 @@ public:
       return symbol;
     }
 
-    if (auto address = RTDyldMemoryManager::getSymbolAddressInProcess(name)) {
+    if (auto address = SymbolCache::getSymbolAddress(name)) {
       return RuntimeDyld::SymbolInfo(address, JITSymbolFlags::Exported);
     }
 
@@ -79,18 +80,52 @@ void GoogleTestRunner::runStaticCtor(llvm::Function *Ctor) {
 }
 
 ExecutionStatus GoogleTestRunner::runTest(Test *test, ObjectFiles &objectFiles) {
-  GoogleTest_Test *GTest = dyn_cast<GoogleTest_Test>(test);
+  std::vector<Test *> tests({ test });
+  return runTests(tests, objectFiles);
+}
+
+ExecutionStatus GoogleTestRunner::runTests(std::vector<Test *> &tests,
+                                           ObjectFiles &objectFiles) {
+  linkObjectFiles(objectFiles);
+  ExecutionStatus status = runLinkedTests(tests);
+  unlinkObjectFiles();
+
+  return status;
+}
 
-  auto Handle =
+void GoogleTestRunner::linkObjectFiles(ObjectFiles &objectFiles) {
+  TraceScope link("link", "runner");
+  linkedObjects =
     ObjectLayer.addObjectSet(objectFiles,
-                             make_unique<SectionMemoryManager>(),
+                             &memoryManager,
                              make_unique<Mull_GoogleTest_Resolver>(overrides));
+  ObjectLayer.emitAndFinalize(linkedObjects);
+}
+
+void GoogleTestRunner::unlinkObjectFiles() {
+  ObjectLayer.removeObjectSet(linkedObjects);
+  memoryManager.reset();
+}
+
+ExecutionStatus GoogleTestRunner::runLinkedTests(std::vector<Test *> &tests) {
+  assert(!tests.empty() && "Expected at least one test");
+
+  /// All the tests share the same static constructors
+  GoogleTest_Test *GTest = dyn_cast<GoogleTest_Test>(tests.front());
 
+  TraceScope staticConstructors("run static constructors", "runner");
   for (auto &Ctor: GTest->GetGlobalCtors()) {
     runStaticCtor(Ctor);
   }
+  staticConstructors.finish();
 
-  std::string filter = "--gtest_filter=" + GTest->getTestName();
+  std::string filter = "--gtest_filter=";
+  for (Test *test : tests) {
+    if (test != tests.front()) {
+      filter += ":";
+    }
+    filter += test->getTestName();
+  }
   const char *argv[] = { "mull", filter.c_str(), NULL };
   int argc = 2;
 
@@ -123,12 +158,12 @@ ExecutionStatus GoogleTestRunner::runTest(Test *test, ObjectFiles &objectFiles)
   void *runAllTestsPtr = getFunctionPointer(fGoogleTestRun);
 
   auto runAllTests = ((int (*)(UnitTest *))(intptr_t)runAllTestsPtr);
+  TraceScope execution("execute test", "runner");
   uint64_t result = runAllTests(unitTest);
+  execution.finish();
 
   overrides.runDestructors();
 
-  ObjectLayer.removeObjectSet(Handle);
-
   if (result == 0) {
     return ExecutionStatus::Passed;
   }
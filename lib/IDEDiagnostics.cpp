@@ -2,8 +2,6 @@
 
 #include "MutationPoint.h"
 
-#include <llvm/IR/DebugInfoMetadata.h>
-#include <llvm/IR/Instruction.h>
 #include <llvm/Support/raw_ostream.h>
 
 using namespace mull;
@@ -20,17 +18,14 @@ void NormalIDEDiagnostics::report(mull::MutationPoint *mutationPoint,
     return;
   }
 
-  Instruction *instruction =
-    dyn_cast<Instruction>(mutationPoint->getOriginalValue());
-  if (instruction->getMetadata(0) == nullptr) {
+  const SourceLocation &location = mutationPoint->getSourceLocation();
+  if (location.isNull()) {
     return;
   }
 
-  const DebugLoc &debugLoc = instruction->getDebugLoc();
-
-  std::string fileNameOrNil = debugLoc->getFilename().str();
-  std::string lineOrNil     = std::to_string(debugLoc->getLine());
-  std::string columnOrNil   = std::to_string(debugLoc->getColumn());
+  std::string fileNameOrNil = location.fileName;
+  std::string lineOrNil     = std::to_string(location.line);
+  std::string columnOrNil   = std::to_string(location.column);
 
   errs() << "\n";
   errs() << fileNameOrNil << ":" << lineOrNil << ":" << columnOrNil << ": "
@@ -1,6 +1,7 @@
 #include "ModuleLoader.h"
 
 #include "Logger.h"
+#include "Tracer.h"
 
 #include <llvm/AsmParser/Parser.h>
 
@@ -9,52 +10,189 @@
 #include <llvm/Bitcode/ReaderWriter.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
-#include <llvm/Support/MD5.h>
+#include <llvm/Support/Endian.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/ThreadPool.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 
 using namespace llvm;
+using namespace llvm::support;
 using namespace mull;
 
-static std::string MD5HashFromBuffer(StringRef buffer) {
-  MD5 Hasher;
-  Hasher.update(buffer);
-  MD5::MD5Result Hash;
-  Hasher.final(Hash);
-  SmallString<32> Result;
-  MD5::stringifyResult(Hash, Result);
-  return Result.str();
+static const uint64_t Prime1 = 11400714785074694791ULL;
+static const uint64_t Prime2 = 14029467366897019727ULL;
+static const uint64_t Prime3 = 1609587929392839161ULL;
+static const uint64_t Prime4 = 9650029242287828579ULL;
+static const uint64_t Prime5 = 2870177450012600261ULL;
+
+static uint64_t rotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
 }
 
-std::unique_ptr<MullModule> ModuleLoader::loadModuleAtPath(const std::string &path) {
-  auto BufferOrError = MemoryBuffer::getFile(path);
+static uint64_t xxRound(uint64_t accumulator, uint64_t input) {
+  accumulator += input * Prime2;
+  accumulator = rotateLeft(accumulator, 31);
+  return accumulator * Prime1;
+}
+
+static uint64_t xxMergeRound(uint64_t accumulator, uint64_t value) {
+  accumulator ^= xxRound(0, value);
+  return accumulator * Prime1 + Prime4;
+}
+
+/// XXH64 with seed 0. It hashes gigabytes per second, while MD5 dominated
+/// loading large projects. LLVM gets llvm/Support/xxhash.h only in 4.0.
+static uint64_t xxHash64(StringRef data) {
+  const unsigned char *position = data.bytes_begin();
+  const unsigned char *const end = data.bytes_end();
+  uint64_t hash;
+
+  if (data.size() >= 32) {
+    const unsigned char *const limit = end - 32;
+    uint64_t v1 = Prime1 + Prime2;
+    uint64_t v2 = Prime2;
+    uint64_t v3 = 0;
+    uint64_t v4 = -Prime1;
+
+    do {
+      v1 = xxRound(v1, endian::read64le(position));
+      v2 = xxRound(v2, endian::read64le(position + 8));
+      v3 = xxRound(v3, endian::read64le(position + 16));
+      v4 = xxRound(v4, endian::read64le(position + 24));
+      position += 32;
+    } while (position <= limit);
+
+    hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) +
+      rotateLeft(v3, 12) + rotateLeft(v4, 18);
+    hash = xxMergeRound(hash, v1);
+    hash = xxMergeRound(hash, v2);
+    hash = xxMergeRound(hash, v3);
+    hash = xxMergeRound(hash, v4);
+  } else {
+    hash = Prime5;
+  }
+
+  hash += data.size();
+
+  while (position + 8 <= end) {
+    hash ^= xxRound(0, endian::read64le(position));
+    hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+    position += 8;
+  }
+
+  if (position + 4 <= end) {
+    hash ^= uint64_t(endian::read32le(position)) * Prime1;
+    hash = rotateLeft(hash, 23) * Prime2 + Prime3;
+    position += 4;
+  }
+
+  while (position < end) {
+    hash ^= (*position) * Prime5;
+    hash = rotateLeft(hash, 11) * Prime1;
+    position++;
+  }
+
+  hash ^= hash >> 33;
+  hash *= Prime2;
+  hash ^= hash >> 29;
+  hash *= Prime3;
+  hash ^= hash >> 32;
+
+  return hash;
+}
+
+static std::string hashFromBuffer(StringRef buffer) {
+  char result[17];
+  snprintf(result, sizeof(result), "%016llx",
+           (unsigned long long)xxHash64(buffer));
+  return result;
+}
+
+static std::unique_ptr<Module> parseModule(const std::string &path,
+                                           LLVMContext &context,
+                                           bool lazy,
+                                           std::string &hash) {
+  /// Bitcode needs no null terminator, that lets large files be mapped
+  /// instead of read
+  auto BufferOrError = MemoryBuffer::getFile(path, -1, false);
   if (!BufferOrError) {
     Logger::error() << "ModuleLoader> Can't load module " << path << '\n';
     return nullptr;
   }
 
-  std::string hash = MD5HashFromBuffer(BufferOrError->get()->getBuffer());
+  TraceScope hashing("hash bitcode", "load");
+  hash = hashFromBuffer(BufferOrError->get()->getBuffer());
+  hashing.finish();
+
+  if (lazy) {
+    /// The module keeps the buffer and reads a function body from it when
+    /// the function is materialized
+    auto llvmModule = getLazyBitcodeModule(std::move(BufferOrError.get()),
+                                           context, true);
+    if (!llvmModule) {
+      Logger::error() << "ModuleLoader> Can't load module " << path << '\n';
+      return nullptr;
+    }
+
+    return std::move(llvmModule.get());
+  }
 
-  auto llvmModule = parseBitcodeFile(BufferOrError->get()->getMemBufferRef(), Ctx);
+  auto llvmModule = parseBitcodeFile(BufferOrError->get()->getMemBufferRef(), context);
   if (!llvmModule) {
     Logger::error() << "ModuleLoader> Can't load module " << path << '\n';
     return nullptr;
   }
 
-  auto module = make_unique<MullModule>(std::move(llvmModule.get()), hash, path);
+  return std::move(llvmModule.get());
+}
+
+std::unique_ptr<MullModule> ModuleLoader::loadModuleAtPath(const std::string &path) {
+  TraceScope scope("load module", "load");
+  std::string hash;
+  auto llvmModule = parseModule(path, Ctx, lazy, hash);
+  if (!llvmModule) {
+    return nullptr;
+  }
+
+  auto module = make_unique<MullModule>(std::move(llvmModule), hash, path);
   return module;
 }
 
 std::vector<std::unique_ptr<MullModule>>
 ModuleLoader::loadModulesFromBitcodeFileList(const std::vector<std::string> &bitcodeFileList) {
-  std::vector<std::unique_ptr<MullModule>> modules;
+  std::vector<std::unique_ptr<MullModule>> loadedModules(bitcodeFileList.size());
 
-  for (const std::string &path : bitcodeFileList) {
-    std::unique_ptr<MullModule> module = loadModuleAtPath(path);
+  if (workers > 1 && bitcodeFileList.size() > 1) {
+    /// An LLVMContext cannot be shared between threads
+    ThreadPool pool(std::min<unsigned>(workers, bitcodeFileList.size()));
+    for (size_t index = 0; index < bitcodeFileList.size(); index++) {
+      const std::string &path = bitcodeFileList[index];
+      pool.async([this, &path, &loadedModules, index]() {
+        TraceScope scope("load module", "load");
+        auto context = make_unique<LLVMContext>();
+        std::string hash;
+        auto llvmModule = parseModule(path, *context, lazy, hash);
+        if (llvmModule) {
+          loadedModules[index] = make_unique<MullModule>(std::move(context),
+                                                         std::move(llvmModule),
+                                                         hash, path);
+        }
+      });
+    }
+    pool.wait();
+  } else {
+    for (size_t index = 0; index < bitcodeFileList.size(); index++) {
+      loadedModules[index] = loadModuleAtPath(bitcodeFileList[index]);
+    }
+  }
 
+  std::vector<std::unique_ptr<MullModule>> modules;
+  for (auto &module : loadedModules) {
     if (module == nullptr) {
       continue;
     }
@@ -1,7 +1,9 @@
 #include "MullModule.h"
 #include "Logger.h"
 
+#include <llvm/ADT/Hashing.h>
 #include <llvm/Bitcode/ReaderWriter.h>
+#include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Support/MemoryBuffer.h>
@@ -31,16 +33,27 @@ static string fileNameFromPath(const string &path) {
 
 MullModule::MullModule(std::unique_ptr<llvm::Module> llvmModule)
   : module(std::move(llvmModule)),
-    uniqueIdentifier("")
+    uniqueIdentifier(""),
+    identifierHash(hash_value(uniqueIdentifier))
 {
 }
 
 MullModule::MullModule(std::unique_ptr<llvm::Module> llvmModule,
-                       const std::string &md5,
+                       const std::string &hash,
                        const std::string &path)
 : module(std::move(llvmModule)), modulePath(path)
 {
-  uniqueIdentifier = fileNameFromPath(module->getModuleIdentifier()) + "_" + md5;
+  uniqueIdentifier = fileNameFromPath(module->getModuleIdentifier()) + "_" + hash;
+  identifierHash = hash_value(uniqueIdentifier);
+}
+
+MullModule::MullModule(std::unique_ptr<llvm::LLVMContext> context,
+                       std::unique_ptr<llvm::Module> llvmModule,
+                       const std::string &hash,
+                       const std::string &path)
+: MullModule(std::move(llvmModule), hash, path)
+{
+  ownedContext = std::move(context);
 }
 
 std::unique_ptr<MullModule> MullModule::clone(LLVMContext &context) {
@@ -59,3 +72,27 @@ std::unique_ptr<MullModule> MullModule::clone(LLVMContext &context) {
   auto module = make_unique<MullModule>(std::move(llvmModule.get()), "", modulePath);
   return module;
 }
+
+void MullModule::materialize(Function *function) {
+  if (!function->isMaterializable()) {
+    return;
+  }
+
+  if (std::error_code error = function->materialize()) {
+    Logger::error() << "MullModule> Can't read the body of "
+                    << function->getName() << ": " << error.message() << '\n';
+  }
+}
+
+void MullModule::releaseFunctionBodies() {
+  for (Function &function : *module) {
+    /// Bodies that were never read take no memory
+    if (function.isDeclaration() || function.isMaterializable()) {
+      continue;
+    }
+
+    function.deleteBody();
+  }
+
+  StripDebugInfo(*module);
+}
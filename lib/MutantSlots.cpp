@@ -0,0 +1,137 @@
+#include "MutantSlots.h"
+
+#include "MullModule.h"
+#include "MutationPoint.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+using namespace mull;
+using namespace llvm;
+
+bool MutantSlots::canDispatch(Function &function) {
+  /// Variadic arguments cannot be forwarded by a plain call
+  return !function.isVarArg() &&
+    !function.hasFnAttribute(Attribute::Naked);
+}
+
+uint64_t *MutantSlots::slotOf(Function *function) {
+  auto slot = functionSlots.find(function);
+  if (slot != functionSlots.end()) {
+    return slot->second;
+  }
+
+  slots.push_back(0);
+  uint64_t *address = &slots.back();
+  functionSlots.insert(std::make_pair(function, address));
+  return address;
+}
+
+/// Ends the block with a call of the callee that passes all the arguments
+/// of the dispatcher through
+static void forwardCall(Function *dispatcher, Function *callee,
+                        BasicBlock *block) {
+  std::vector<Value *> arguments;
+  for (Argument &argument : dispatcher->args()) {
+    arguments.push_back(&argument);
+  }
+
+  IRBuilder<> builder(block);
+  CallInst *call = builder.CreateCall(callee, arguments);
+  call->setTailCall();
+  call->setCallingConv(callee->getCallingConv());
+  call->setAttributes(callee->getAttributes());
+
+  if (dispatcher->getReturnType()->isVoidTy()) {
+    builder.CreateRetVoid();
+  } else {
+    builder.CreateRet(call);
+  }
+}
+
+void MutantSlots::addDispatcher(MullModule &clone,
+                                Function *function,
+                                const std::vector<MutationPoint *> &mutationPoints) {
+  assert(canDispatch(*function) && "The function cannot be dispatched");
+
+  Module *module = clone.getModule();
+  LLVMContext &context = module->getContext();
+  Function *original = module->getFunction(function->getName());
+  assert(original && !original->isDeclaration() &&
+         "The clone must contain the function");
+
+  /// Each mutant is made from a pristine copy of the function. The mutation
+  /// finds its instruction by the index of the function in the module, so the
+  /// copy takes the place of the original while the mutation is applied.
+  std::vector<Function *> mutants;
+  for (MutationPoint *mutationPoint : mutationPoints) {
+    ValueToValueMapTy map;
+    Function *mutant = CloneFunction(original, map);
+
+    mutant->removeFromParent();
+    module->getFunctionList().insert(original->getIterator(), mutant);
+    mutationPoint->applyMutation(clone);
+    mutant->removeFromParent();
+    module->getFunctionList().push_back(mutant);
+
+    mutant->setName(original->getName() + ".mull_mutant_" +
+                    Twine(mutants.size() + 1));
+    mutant->setLinkage(GlobalValue::InternalLinkage);
+    mutant->setVisibility(GlobalValue::DefaultVisibility);
+    mutant->setComdat(nullptr);
+    mutants.push_back(mutant);
+  }
+
+  Function *dispatcher = Function::Create(original->getFunctionType(),
+                                          original->getLinkage(),
+                                          "",
+                                          module);
+  dispatcher->copyAttributesFrom(original);
+  dispatcher->setComdat(original->getComdat());
+
+  /// Every caller, including the mutants calling themselves, goes through
+  /// the dispatcher from now on
+  original->replaceAllUsesWith(dispatcher);
+  dispatcher->takeName(original);
+  original->setName(dispatcher->getName() + ".mull_original");
+  original->setLinkage(GlobalValue::InternalLinkage);
+  original->setVisibility(GlobalValue::DefaultVisibility);
+  original->setComdat(nullptr);
+
+  /// The address of the slot is embedded as a constant, the same way the
+  /// call tree callbacks refer to the driver
+  Type *int64Type = Type::getInt64Ty(context);
+  uint32_t pointerWidth = module->getDataLayout().getPointerSizeInBits();
+  ConstantInt *slotAddress =
+    ConstantInt::get(context, APInt(pointerWidth, (uint64_t)slotOf(function)));
+  Value *slot = ConstantExpr::getCast(Instruction::IntToPtr,
+                                      slotAddress,
+                                      int64Type->getPointerTo());
+
+  BasicBlock *entry = BasicBlock::Create(context, "entry", dispatcher);
+  BasicBlock *originalBlock = BasicBlock::Create(context, "original", dispatcher);
+  forwardCall(dispatcher, original, originalBlock);
+
+  IRBuilder<> builder(entry);
+  Value *activeMutant = builder.CreateLoad(slot, "mutant");
+  SwitchInst *dispatch = builder.CreateSwitch(activeMutant,
+                                              originalBlock,
+                                              mutants.size());
+  for (size_t index = 0; index < mutants.size(); index++) {
+    BasicBlock *mutantBlock = BasicBlock::Create(context, "mutant", dispatcher);
+    forwardCall(dispatcher, mutants[index], mutantBlock);
+    dispatch->addCase(ConstantInt::get(cast<IntegerType>(int64Type), index + 1),
+                      mutantBlock);
+  }
+}
+
+void MutantSlots::activate(Function *function, uint64_t mutant) {
+  *slotOf(function) = mutant;
+}
+
+void MutantSlots::deactivate(Function *function) {
+  *slotOf(function) = 0;
+}
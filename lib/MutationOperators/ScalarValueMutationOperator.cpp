@@ -31,6 +31,8 @@ const std::string ScalarValueMutationOperator::ID = "scalar_value_mutation_opera
 static
 ScalarValueMutationType findPossibleApplication(Value &V,
                                                 std::string &outDiagnostics);
+static APInt getReplacementIntValue(ConstantInt *constantInt);
+static APFloat getReplacementFloatValue(ConstantFP *constantFloat);
 static ConstantInt *getReplacementInt(ConstantInt *constantInt);
 static ConstantFP *getReplacementFloat(ConstantFP *constantFloat);
 
@@ -85,8 +87,10 @@ ScalarValueMutationType findPossibleApplication(Value &V,
       if (ConstantInt *constantInt = dyn_cast<ConstantInt>(operand)) {
         auto intValue = constantInt->getValue();
 
-        auto replacementInt = getReplacementInt(constantInt);
-        auto replacementIntValue = replacementInt->getValue();
+        /// Only compute the replacement value here: creating constants
+        /// modifies LLVMContext, while mutation points may be searched for
+        /// from several threads at once.
+        auto replacementIntValue = getReplacementIntValue(constantInt);
 
         /// Skip big number because getSExtValue throws otherwise.
         /// TODO: consider these edge cases in unit tests.
@@ -108,8 +112,7 @@ ScalarValueMutationType findPossibleApplication(Value &V,
 
       if (ConstantFP *constantFloat = dyn_cast<ConstantFP>(operand)) {
         auto floatValue = constantFloat->getValueAPF();
-        auto replacementFloat = getReplacementFloat(constantFloat);
-        auto replacementFloatValue = replacementFloat->getValueAPF();
+        auto replacementFloatValue = getReplacementFloatValue(constantFloat);
 
         std::stringstream diagstream;
         diagstream << "Scalar Value Replacement: ";
@@ -128,11 +131,26 @@ ScalarValueMutationType findPossibleApplication(Value &V,
   return ScalarValueMutationType::None;
 }
 
-static ConstantInt *getReplacementInt(ConstantInt *constantInt) {
+static APInt getReplacementIntValue(ConstantInt *constantInt) {
   uint64_t replacementValue = constantInt->isZero() ? 1 : 0;
 
-  APInt replacementIntValue =
-    APInt(constantInt->getBitWidth(), replacementValue);
+  return APInt(constantInt->getBitWidth(), replacementValue);
+}
+
+static APFloat getReplacementFloatValue(ConstantFP *constantFloat) {
+  auto floatValue = constantFloat->getValueAPF();
+
+  // TODO: review the rules for mutation.
+  if (floatValue.isZero()) {
+    // TODO: Didn't find a better way of creating APFloat for number 1.
+    return APFloat((double)1);
+  }
+
+  return APFloat::getZero(floatValue.getSemantics());
+}
+
+static ConstantInt *getReplacementInt(ConstantInt *constantInt) {
+  APInt replacementIntValue = getReplacementIntValue(constantInt);
 
   ConstantInt *replacement =
     dyn_cast<ConstantInt>(ConstantInt::get(constantInt->getType(),
@@ -142,29 +160,13 @@ static ConstantInt *getReplacementInt(ConstantInt *constantInt) {
 }
 
 static ConstantFP *getReplacementFloat(ConstantFP *constantFloat) {
-  auto floatValue = constantFloat->getValueAPF();
-
-    // TODO: review the rules for mutation.
-  if (floatValue.isZero()) {
+  APFloat replacementFloatValue = getReplacementFloatValue(constantFloat);
 
-    // TODO: Didn't find a better way of creating APFloat for number 1.
-    APFloat replacementFloatValue = APFloat((double)1);
-    ConstantFP *replacement =
-      dyn_cast<ConstantFP>(ConstantFP::get(constantFloat->getContext(),
-                                           replacementFloatValue));
+  ConstantFP *replacement =
+    dyn_cast<ConstantFP>(ConstantFP::get(constantFloat->getContext(),
+                                         replacementFloatValue));
 
-    return replacement;
-  }
-  else {
-    APFloat replacementFloatValue = APFloat::getZero(floatValue.getSemantics());
-    ConstantFP *replacement =
-      dyn_cast<ConstantFP>(ConstantFP::get(constantFloat->getContext(),
-                                           replacementFloatValue));
-
-    return replacement;
-  }
-
-  return nullptr;
+  return replacement;
 }
 
 llvm::Value *
@@ -3,6 +3,9 @@
 #include "ModuleLoader.h"
 
 #include "MutationOperators/MutationOperator.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Instruction.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 
 using namespace llvm;
@@ -61,11 +64,23 @@ MutationPoint::MutationPoint(MutationOperator *op,
                              std::string diagnostics) :
   mutationOperator(op), Address(Address), OriginalValue(Val), module(m), diagnostics(diagnostics)
 {
-  string moduleID = module->getUniqueIdentifier();
-  string addressID = Address.getIdentifier();
-  string operatorID = mutationOperator->uniqueID();
-
-  uniqueIdentifier = moduleID + "_" + addressID + "_" + operatorID;
+  identifierHash = hash_combine(module->getIdentifierHash(),
+                                Address.getFnIndex(),
+                                Address.getBBIndex(),
+                                Address.getIIndex(),
+                                hash_value(mutationOperator->uniqueID()));
+
+  if (Instruction *instruction = dyn_cast<Instruction>(Val)) {
+    functionName = instruction->getFunction()->getName().str();
+
+    if (instruction->getMetadata(0)) {
+      const DebugLoc &debugLoc = instruction->getDebugLoc();
+      sourceLocation.fileName = debugLoc->getFilename().str();
+      sourceLocation.directory = debugLoc->getDirectory().str();
+      sourceLocation.line = debugLoc->getLine();
+      sourceLocation.column = debugLoc->getColumn();
+    }
+  }
 }
 
 MutationPoint::~MutationPoint() {}
@@ -102,16 +117,21 @@ MullModule *MutationPoint::getOriginalModule() const {
   return module;
 }
 
+/// The operator gets the instruction of the module being mutated,
+/// the original one may be released by now
 void MutationPoint::applyMutation(MullModule &module) {
-  mutationOperator->applyMutation(module.getModule(), Address, *OriginalValue);
+  Instruction &instruction = Address.findInstruction(module.getModule());
+  mutationOperator->applyMutation(module.getModule(), Address, instruction);
 }
 
-std::string MutationPoint::getUniqueIdentifier() {
-  return uniqueIdentifier;
+MutationPointID MutationPoint::getIdentifierHash() const {
+  return identifierHash;
 }
 
 std::string MutationPoint::getUniqueIdentifier() const {
-  return uniqueIdentifier;
+  return module->getUniqueIdentifier() + "_" +
+    Address.getIdentifier() + "_" +
+    mutationOperator->uniqueID();
 }
 
 const std::string &MutationPoint::getDiagnostics() {
@@ -121,3 +141,11 @@ const std::string &MutationPoint::getDiagnostics() {
 const std::string &MutationPoint::getDiagnostics() const {
   return diagnostics;
 }
+
+const std::string &MutationPoint::getFunctionName() const {
+  return functionName;
+}
+
+const SourceLocation &MutationPoint::getSourceLocation() const {
+  return sourceLocation;
+}
@@ -3,9 +3,13 @@
 #include "Filter.h"
 #include "Testee.h"
 #include "MutationPoint.h"
+#include "Tracer.h"
 
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/ThreadPool.h>
+
+#include <set>
 
 using namespace mull;
 using namespace llvm;
@@ -31,9 +35,70 @@ MutationsFinder::MutationsFinder(std::vector<std::unique_ptr<MutationOperator>>
 std::vector<MutationPoint *> MutationsFinder::getMutationPoints(const Context &context,
                                                                 Testee &testee,
                                                                 Filter &filter) {
+  Function *function = testee.getTesteeFunction();
+
+  auto cached = cachedPoints.find(function);
+  if (cached != cachedPoints.end()) {
+    return cached->second;
+  }
+
   std::vector<MutationPoint *> points;
+  for (auto &point : findMutationPointsInFunction(context, function, filter)) {
+    points.push_back(point.get());
+    ownedPoints.push_back(std::move(point));
+  }
+
+  cachedPoints.insert(std::make_pair(function, points));
+
+  return points;
+}
+
+void MutationsFinder::findMutationPoints(const Context &context,
+                                         const std::vector<Function *> &functions,
+                                         Filter &filter,
+                                         unsigned workers) {
+  std::vector<Function *> pendingFunctions;
+  std::set<Function *> seenFunctions;
+  for (Function *function : functions) {
+    if (cachedPoints.count(function) == 0 &&
+        seenFunctions.insert(function).second) {
+      pendingFunctions.push_back(function);
+    }
+  }
+
+  /// Each task writes only into its own slot, no synchronization is needed
+  std::vector<std::vector<std::unique_ptr<MutationPoint>>>
+    foundPoints(pendingFunctions.size());
+
+  {
+    ThreadPool pool(std::max(1u, workers));
+    for (size_t index = 0; index < pendingFunctions.size(); index++) {
+      pool.async([this, &context, &filter, &pendingFunctions, &foundPoints, index]() {
+        TraceScope scope("scan function", "discovery");
+        foundPoints[index] = findMutationPointsInFunction(context,
+                                                         pendingFunctions[index],
+                                                         filter);
+      });
+    }
+    pool.wait();
+  }
+
+  for (size_t index = 0; index < pendingFunctions.size(); index++) {
+    std::vector<MutationPoint *> points;
+    for (auto &point : foundPoints[index]) {
+      points.push_back(point.get());
+      ownedPoints.push_back(std::move(point));
+    }
+    cachedPoints.insert(std::make_pair(pendingFunctions[index], points));
+  }
+}
+
+std::vector<std::unique_ptr<MutationPoint>>
+MutationsFinder::findMutationPointsInFunction(const Context &context,
+                                              Function *function,
+                                              Filter &filter) {
+  std::vector<std::unique_ptr<MutationPoint>> points;
 
-  Function *function = testee.getTesteeFunction();
   auto moduleID = function->getParent()->getModuleIdentifier();
   MullModule *module = context.moduleWithIdentifier(moduleID);
 
@@ -55,8 +120,7 @@ std::vector<MutationPoint *> MutationsFinder::getMutationPoints(const Context &c
                                                                   address,
                                                                   &instruction);
         if (point) {
-          points.push_back(point);
-          ownedPoints.emplace_back(std::unique_ptr<MutationPoint>(point));
+          points.emplace_back(std::unique_ptr<MutationPoint>(point));
         }
         instructionIndex++;
       }
@@ -0,0 +1,181 @@
+#include "ProgressReporter.h"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cassert>
+#include <sstream>
+
+using namespace mull;
+using namespace llvm;
+using namespace std::chrono;
+
+ProgressReporter::Format
+ProgressReporter::formatFromString(const std::string &format) {
+  if (format == "text") {
+    return Format::Text;
+  }
+  if (format == "json") {
+    return Format::JSON;
+  }
+  return Format::None;
+}
+
+ProgressReporter::ProgressReporter(Format format, int intervalSeconds,
+                                   raw_ostream &out)
+  : format(format), interval(intervalSeconds), out(out),
+    planned(0), finished(0), killed(0), survived(0), timedOut(0), other(0),
+    startTime(steady_clock::now()), lastReportTime(startTime) {}
+
+int ProgressReporter::addTest(long long baselineMilliseconds, int mutants) {
+  tests.push_back({ baselineMilliseconds, mutants, 0, 0, 0 });
+  planned += mutants;
+  return tests.size() - 1;
+}
+
+void ProgressReporter::start() {
+  startTime = steady_clock::now();
+  lastReportTime = startTime;
+}
+
+void ProgressReporter::mutantFinished(int test, ExecutionStatus status,
+                                      long long milliseconds, bool skipped) {
+  assert(test >= 0 && test < (int)tests.size() && "Unknown test");
+
+  TestProgress &progress = tests[test];
+  progress.finished++;
+  if (!skipped) {
+    progress.sampled++;
+    progress.spentMilliseconds += milliseconds;
+  }
+  finished++;
+
+  switch (status) {
+    case Failed:
+    case Crashed:
+    case AbnormalExit:
+      killed++;
+      break;
+    case Passed:
+      survived++;
+      break;
+    case Timedout:
+      timedOut++;
+      break;
+    default:
+      other++;
+      break;
+  }
+
+  if (format == Format::None) {
+    return;
+  }
+
+  auto now = steady_clock::now();
+  if (now - lastReportTime >= interval) {
+    lastReportTime = now;
+    report();
+  }
+}
+
+void ProgressReporter::finish() {
+  if (format == Format::None) {
+    return;
+  }
+  report();
+}
+
+long long ProgressReporter::estimateRemainingMilliseconds() const {
+  /// How much slower the mutants are than the baselines of their tests
+  long long observedMilliseconds = 0;
+  long long observedBaselineMilliseconds = 0;
+  for (const TestProgress &test : tests) {
+    observedMilliseconds += test.spentMilliseconds;
+    observedBaselineMilliseconds += test.baselineMilliseconds * test.sampled;
+  }
+  double slowdown = 1.0;
+  if (observedBaselineMilliseconds > 0) {
+    slowdown = double(observedMilliseconds) / observedBaselineMilliseconds;
+  }
+
+  double remaining = 0;
+  for (const TestProgress &test : tests) {
+    int remainingMutants = test.planned - test.finished;
+    if (remainingMutants <= 0) {
+      continue;
+    }
+
+    double costPerMutant = test.baselineMilliseconds * slowdown;
+    if (test.sampled > 0) {
+      costPerMutant = double(test.spentMilliseconds) / test.sampled;
+    }
+    remaining += remainingMutants * costPerMutant;
+  }
+
+  return (long long)remaining;
+}
+
+double ProgressReporter::mutantsPerSecond() const {
+  double elapsed = duration<double>(steady_clock::now() - startTime).count();
+  if (elapsed <= 0) {
+    return 0;
+  }
+  return finished / elapsed;
+}
+
+static std::string formatDuration(long long milliseconds) {
+  long long seconds = milliseconds / 1000;
+  std::string result;
+  raw_string_ostream stream(result);
+  if (seconds >= 3600) {
+    stream << seconds / 3600 << "h ";
+  }
+  if (seconds >= 60) {
+    stream << llvm::format("%02lldm ", (seconds % 3600) / 60);
+  }
+  stream << llvm::format("%02llds", seconds % 60);
+  return stream.str();
+}
+
+std::string ProgressReporter::textReport() const {
+  double percent = planned ? 100.0 * finished / planned : 100.0;
+
+  std::string result;
+  raw_string_ostream stream(result);
+  stream << "Progress> " << finished << "/" << planned << " mutants"
+         << llvm::format(" (%.1f%%), %.2f mutants/s", percent, mutantsPerSecond())
+         << ", killed: " << killed
+         << ", survived: " << survived
+         << ", timed out: " << timedOut
+         << ", other: " << other
+         << ", ETA: " << formatDuration(estimateRemainingMilliseconds());
+  return stream.str();
+}
+
+std::string ProgressReporter::jsonReport() const {
+  long long elapsed =
+    duration_cast<milliseconds>(steady_clock::now() - startTime).count();
+
+  std::string result;
+  raw_string_ostream stream(result);
+  stream << "{\"finished\":" << finished
+         << ",\"planned\":" << planned
+         << ",\"killed\":" << killed
+         << ",\"survived\":" << survived
+         << ",\"timed_out\":" << timedOut
+         << ",\"other\":" << other
+         << llvm::format(",\"mutants_per_second\":%.3f", mutantsPerSecond())
+         << ",\"elapsed_ms\":" << elapsed
+         << ",\"eta_ms\":" << estimateRemainingMilliseconds()
+         << "}";
+  return stream.str();
+}
+
+void ProgressReporter::report() {
+  if (format == Format::JSON) {
+    out << jsonReport() << "\n";
+  } else {
+    out << textReport() << "\n";
+  }
+  out.flush();
+}
@@ -0,0 +1,192 @@
+#include "RecyclingMemoryManager.h"
+
+#include "Logger.h"
+
+#include <llvm/Support/MathExtras.h>
+#include <llvm/Support/Memory.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace mull;
+using namespace llvm;
+
+static size_t pageSize() {
+  static const size_t size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+static uint8_t *mapMemory(size_t size, int flags) {
+  void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+  return (uint8_t *)address;
+}
+
+RecyclingMemoryManager::RecyclingMemoryManager(size_t reservation)
+  : region(nullptr), regionSize(0), code({ nullptr, 0, 0, 0 }),
+    data({ nullptr, 0, 0, 0 })
+{
+  regionSize = alignTo(reservation, 2 * pageSize());
+
+  /// Only the address space is reserved here, the pages are backed lazily
+  region = mapMemory(regionSize, MAP_NORESERVE);
+  if (region == nullptr) {
+    Logger::error() << "RecyclingMemoryManager> cannot reserve "
+                    << regionSize << " bytes: " << strerror(errno) << "\n";
+    regionSize = 0;
+    return;
+  }
+
+#ifdef MADV_HUGEPAGE
+  /// Fewer page faults and TLB misses when the kernel has huge pages
+  madvise(region, regionSize, MADV_HUGEPAGE);
+#endif
+
+  code = { region, regionSize / 2, 0, 0 };
+  data = { region + regionSize / 2, regionSize / 2, 0, 0 };
+}
+
+RecyclingMemoryManager::~RecyclingMemoryManager() {
+  reset();
+
+  if (region) {
+    munmap(region, regionSize);
+  }
+}
+
+uint8_t *RecyclingMemoryManager::allocate(Arena &arena, uintptr_t size,
+                                          unsigned alignment, bool isCode) {
+  alignment = std::max(alignment, 16u);
+
+  uintptr_t base = (uintptr_t)arena.base;
+  uintptr_t start = alignTo(base + arena.used, alignment);
+  if (arena.base == nullptr || start + size > base + arena.size) {
+    return allocateOverflow(size, isCode);
+  }
+
+  arena.used = start + size - base;
+  return (uint8_t *)start;
+}
+
+uint8_t *RecyclingMemoryManager::allocateOverflow(uintptr_t size,
+                                                  bool isCode) {
+  size_t mappingSize = alignTo(std::max<uintptr_t>(size, 1), pageSize());
+  uint8_t *address = mapMemory(mappingSize, 0);
+  if (address == nullptr) {
+    Logger::error() << "RecyclingMemoryManager> cannot allocate "
+                    << size << " bytes: " << strerror(errno) << "\n";
+    return nullptr;
+  }
+
+  overflow.push_back({ address, mappingSize, isCode, false });
+  return address;
+}
+
+uint8_t *RecyclingMemoryManager::allocateCodeSection(uintptr_t size,
+                                                     unsigned alignment,
+                                                     unsigned sectionID,
+                                                     StringRef sectionName) {
+  return allocate(code, size, alignment, true);
+}
+
+uint8_t *RecyclingMemoryManager::allocateDataSection(uintptr_t size,
+                                                     unsigned alignment,
+                                                     unsigned sectionID,
+                                                     StringRef sectionName,
+                                                     bool isReadOnly) {
+  return allocate(data, size, alignment, false);
+}
+
+bool RecyclingMemoryManager::finalizeMemory(std::string *errorMessage) {
+  /// Code allocated after this point starts on a fresh, writable page
+  size_t end = alignTo(code.used, pageSize());
+  if (end > code.finalized) {
+    uint8_t *start = code.base + code.finalized;
+    size_t size = end - code.finalized;
+
+    if (mprotect(start, size, PROT_READ | PROT_EXEC) != 0) {
+      if (errorMessage) {
+        *errorMessage = strerror(errno);
+      }
+      return true;
+    }
+    sys::Memory::InvalidateInstructionCache(start, size);
+
+    code.used = end;
+    code.finalized = end;
+  }
+
+  for (Mapping &mapping : overflow) {
+    if (!mapping.isCode || mapping.finalized) {
+      continue;
+    }
+
+    if (mprotect(mapping.address, mapping.size, PROT_READ | PROT_EXEC) != 0) {
+      if (errorMessage) {
+        *errorMessage = strerror(errno);
+      }
+      return true;
+    }
+    sys::Memory::InvalidateInstructionCache(mapping.address, mapping.size);
+    mapping.finalized = true;
+  }
+
+  return false;
+}
+
+void RecyclingMemoryManager::registerEHFrames(uint8_t *address,
+                                              uint64_t loadAddress,
+                                              size_t size) {
+  RTDyldMemoryManager::registerEHFrames(address, loadAddress, size);
+  frames.push_back({ address, loadAddress, size });
+}
+
+void RecyclingMemoryManager::deregisterEHFrames(uint8_t *address,
+                                                uint64_t loadAddress,
+                                                size_t size) {
+  auto frame = std::find_if(frames.begin(), frames.end(),
+                            [&](const EHFrame &frame) {
+                              return frame.address == address;
+                            });
+  if (frame == frames.end()) {
+    return;
+  }
+
+  frames.erase(frame);
+  RTDyldMemoryManager::deregisterEHFrames(address, loadAddress, size);
+}
+
+void RecyclingMemoryManager::reset() {
+  /// The unwinder must not see the frames of the code about to be overwritten
+  for (EHFrame &frame : frames) {
+    RTDyldMemoryManager::deregisterEHFrames(frame.address, frame.loadAddress,
+                                            frame.size);
+  }
+  frames.clear();
+
+  if (code.finalized) {
+    mprotect(code.base, code.finalized, PROT_READ | PROT_WRITE);
+  }
+  code.used = 0;
+  code.finalized = 0;
+  data.used = 0;
+
+  for (Mapping &mapping : overflow) {
+    munmap(mapping.address, mapping.size);
+  }
+  overflow.clear();
+}
+
+size_t RecyclingMemoryManager::bytesInUse() const {
+  size_t bytes = code.used + data.used;
+  for (const Mapping &mapping : overflow) {
+    bytes += mapping.size;
+  }
+  return bytes;
+}
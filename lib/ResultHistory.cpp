@@ -0,0 +1,146 @@
+#include "ResultHistory.h"
+
+#include "Logger.h"
+#include "SQLiteReporter.h"
+
+#include "MutationOperators/MutationOperator.h"
+
+#include <llvm/Support/FileSystem.h>
+
+#include <sqlite3.h>
+
+using namespace mull;
+using namespace llvm;
+
+static const char *SelectResultsSQL =
+  "SELECT test.test_name, test.test_hash, "
+  "mutation_point.function_name, mutation_point.function_hash, "
+  "mutation_point.basic_block_index, mutation_point.instruction_index, "
+  "mutation_point.mutation_operator, execution.status, execution.duration "
+  "FROM mutation_execution "
+  "JOIN test ON test.id = mutation_execution.test_id "
+  "JOIN mutation_point ON mutation_point.id = mutation_execution.mutation_point_id "
+  "JOIN execution ON execution.id = mutation_execution.execution_result_id "
+  "WHERE test.test_hash != '' AND mutation_point.function_hash != '';";
+
+static std::string columnText(sqlite3_stmt *stmt, int column) {
+  const unsigned char *text = sqlite3_column_text(stmt, column);
+  return text ? std::string((const char *)text) : std::string();
+}
+
+std::string ResultHistory::key(const std::string &testName,
+                               const std::string &testHash,
+                               const std::string &functionName,
+                               const std::string &functionHash,
+                               int basicBlockIndex,
+                               int instructionIndex,
+                               const std::string &mutationOperator) {
+  return testName + "|" + testHash + "|" +
+         functionName + "|" + functionHash + "|" +
+         std::to_string(basicBlockIndex) + "|" +
+         std::to_string(instructionIndex) + "|" +
+         mutationOperator;
+}
+
+void ResultHistory::load(const std::string &databasePath) {
+  if (!sys::fs::exists(databasePath)) {
+    Logger::error() << "ResultHistory> " << databasePath
+                    << " does not exist, running every mutant\n";
+    return;
+  }
+
+  /// sqlite3_open_v2 hands out a handle even when it fails,
+  /// which still has to be closed
+  sqlite3 *database = nullptr;
+  if (sqlite3_open_v2(databasePath.c_str(), &database,
+                      SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+    Logger::error() << "ResultHistory> Cannot open " << databasePath << ": "
+                    << sqlite3_errmsg(database) << ", running every mutant\n";
+    sqlite3_close(database);
+    return;
+  }
+
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(database, "PRAGMA user_version;",
+                         -1, &stmt, nullptr) != SQLITE_OK) {
+    Logger::error() << "ResultHistory> Cannot read " << databasePath << ": "
+                    << sqlite3_errmsg(database) << ", running every mutant\n";
+    sqlite3_close(database);
+    return;
+  }
+  int version = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+  sqlite3_finalize(stmt);
+
+  if (version != SQLiteReporter::SchemaVersion) {
+    Logger::error() << "ResultHistory> " << databasePath
+                    << " was written by an incompatible version of Mull, "
+                    << "running every mutant\n";
+    sqlite3_close(database);
+    return;
+  }
+
+  if (sqlite3_prepare_v2(database, SelectResultsSQL,
+                         -1, &stmt, nullptr) != SQLITE_OK) {
+    Logger::error() << "ResultHistory> Cannot read " << databasePath << ": "
+                    << sqlite3_errmsg(database) << ", running every mutant\n";
+    sqlite3_close(database);
+    return;
+  }
+
+  int status;
+  while ((status = sqlite3_step(stmt)) == SQLITE_ROW) {
+    ExecutionResult result;
+    result.status = ExecutionStatus(sqlite3_column_int(stmt, 7));
+    result.runningTime = sqlite3_column_int64(stmt, 8);
+    result.exitStatus = 0;
+
+    if (result.status == Invalid || result.status == DryRun) {
+      continue;
+    }
+
+    std::string resultKey = key(columnText(stmt, 0),
+                                columnText(stmt, 1),
+                                columnText(stmt, 2),
+                                columnText(stmt, 3),
+                                sqlite3_column_int(stmt, 4),
+                                sqlite3_column_int(stmt, 5),
+                                columnText(stmt, 6));
+    results.insert(std::make_pair(resultKey, result));
+  }
+
+  /// The results read so far are still valid, the rest of the mutants run
+  if (status != SQLITE_DONE) {
+    Logger::error() << "ResultHistory> Cannot read all of " << databasePath
+                    << ": " << sqlite3_errmsg(database) << '\n';
+  }
+  sqlite3_finalize(stmt);
+
+  sqlite3_close(database);
+
+  Logger::debug() << "ResultHistory> loaded " << results.size()
+                  << " results from " << databasePath << "\n";
+}
+
+bool ResultHistory::lookup(TestResult &testResult,
+                           MutationPoint &mutationPoint,
+                           const std::string &functionHash,
+                           ExecutionResult &result) const {
+  if (results.empty() || functionHash.empty() ||
+      testResult.getTestHash().empty()) {
+    return false;
+  }
+
+  auto found = results.find(key(testResult.getDisplayName(),
+                                testResult.getTestHash(),
+                                mutationPoint.getFunctionName(),
+                                functionHash,
+                                mutationPoint.getAddress().getBBIndex(),
+                                mutationPoint.getAddress().getIIndex(),
+                                mutationPoint.getOperator()->uniqueID()));
+  if (found == results.end()) {
+    return false;
+  }
+
+  result = found->second;
+  return true;
+}
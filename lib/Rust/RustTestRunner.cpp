@@ -9,9 +9,9 @@
 #include "llvm/ExecutionEngine/OrcMCJITReplacement.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
 #include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
-#include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/Support/DynamicLibrary.h"
 #include "llvm/Support/TargetSelect.h"
+#include "SymbolCache.h"
 
 #include <chrono>
 #include <dlfcn.h>
@@ -25,7 +25,7 @@ class Mull_Rust_Resolver : public RuntimeDyld::SymbolResolver {
 public:
 
   RuntimeDyld::SymbolInfo findSymbol(const std::string &Name) {
-    if (auto SymAddr = RTDyldMemoryManager::getSymbolAddressInProcess(Name)) {
+    if (auto SymAddr = SymbolCache::getSymbolAddress(Name)) {
       return RuntimeDyld::SymbolInfo(SymAddr, JITSymbolFlags::Exported);
     }
 
@@ -55,7 +55,7 @@ ExecutionResult RustTestRunner::runTest(Test *Test, ObjectFiles &objectFiles) {
   RustTest *rustTest = dyn_cast<RustTest>(Test);
 
   auto handle = objectLayer.addObjectSet(objectFiles,
-                                         make_unique<SectionMemoryManager>(),
+                                         &memoryManager,
                                          make_unique<Mull_Rust_Resolver>());
 
   auto start = high_resolution_clock::now();
@@ -82,6 +82,7 @@ ExecutionResult RustTestRunner::runTest(Test *Test, ObjectFiles &objectFiles) {
   Result.RunningTime = duration_cast<std::chrono::milliseconds>(elapsed).count();
 
   objectLayer.removeObjectSet(handle);
+  memoryManager.reset();
 
   return Result;
 }
@@ -2,17 +2,24 @@
 
 #include "Config.h"
 #include "Logger.h"
+#include "MullModule.h"
 #include "Result.h"
 #include "TestResult.h"
+#include "Tracer.h"
 
 #include "MutationOperators/MutationOperator.h"
 
+#include "llvm/ADT/SmallString.h"
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
 #include <sqlite3.h>
 #include <sstream>
 #include <string>
@@ -24,14 +31,6 @@ using namespace llvm;
 
 static void createTables(sqlite3 *database);
 
-static void assume(bool condition, const char *assumption) {
-  if (condition) {
-    return;
-  }
-
-  Logger::warn() << "Assumption failed: " << assumption << '\n';
-}
-
 static std::string vectorToCsv(const std::vector<std::string> &v) {
   if (v.empty()) {
     return std::string();
@@ -66,6 +65,180 @@ void sqlite_step(sqlite3 *database, sqlite3_stmt *stmt) {
     Logger::error() << "Shutting down\n";
     exit(18);
   }
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+}
+
+static sqlite3_stmt *sqlite_prepare(sqlite3 *database, const char *sql) {
+  sqlite3_stmt *stmt = nullptr;
+  int result = sqlite3_prepare_v2(database, sql, -1, &stmt, nullptr);
+  if (result != SQLITE_OK) {
+    Logger::error() << "Cannot prepare " << sql << '\n';
+    Logger::error() << "Reason: '" << sqlite3_errmsg(database) << "'\n";
+    Logger::error() << "Shutting down\n";
+    exit(18);
+  }
+  return stmt;
+}
+
+/// Binds a text parameter. SQLITE_TRANSIENT makes SQLite copy the value,
+/// so temporaries can be passed safely.
+static void sqlite_bind_text(sqlite3_stmt *stmt, int index,
+                             const std::string &value) {
+  sqlite3_bind_text(stmt, index, value.c_str(), value.size(), SQLITE_TRANSIENT);
+}
+
+static void sqlite_bind_int(sqlite3_stmt *stmt, int index, int64_t value) {
+  sqlite3_bind_int64(stmt, index, value);
+}
+
+static std::string md5(StringRef data) {
+  MD5 hasher;
+  hasher.update(data);
+
+  MD5::MD5Result hash;
+  hasher.final(hash);
+
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str();
+}
+
+#pragma mark - Statements
+
+/// Outputs shorter than this are stored as is, compressing them saves little
+static const size_t CompressionThreshold = 256;
+
+static const char *InsertExecutionSQL =
+  "INSERT INTO execution (status, duration, stdout_id, stderr_id) "
+  "VALUES (?1, ?2, ?3, ?4);";
+
+static const char *SelectOutputBlobSQL =
+  "SELECT id FROM output_blob WHERE hash = ?1;";
+
+static const char *InsertOutputBlobSQL =
+  "INSERT INTO output_blob (hash, size, compressed, data) "
+  "VALUES (?1, ?2, ?3, ?4);";
+
+static const char *SelectTestSQL =
+  "SELECT id FROM test WHERE test_name = ?1;";
+
+static const char *InsertTestSQL =
+  "INSERT INTO test (test_name, execution_result_id, test_hash) "
+  "VALUES (?1, ?2, ?3);";
+
+static const char *SelectMutationPointSQL =
+  "SELECT id FROM mutation_point WHERE unique_id = ?1;";
+
+static const char *InsertMutationPointSQL =
+  "INSERT INTO mutation_point (mutation_operator, module_name, function_name, "
+  "function_index, basic_block_index, instruction_index, filename, directory, "
+  "diagnostics, line_number, column_number, unique_id, function_hash) "
+  "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13);";
+
+static const char *InsertMutationPointDebugSQL =
+  "INSERT OR IGNORE INTO mutation_point_debug (mutation_point_id, filename, "
+  "line_number, column_number, function, basic_block, instruction, unique_id) "
+  "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8);";
+
+static const char *InsertMutationExecutionSQL =
+  "INSERT INTO mutation_execution (execution_result_id, test_id, "
+  "mutation_point_id, mutation_distance, alias_of_id) "
+  "VALUES (?1, ?2, ?3, ?4, ?5);";
+
+static const char *InsertRunInfoSQL =
+  "INSERT INTO run_info VALUES (?1, ?2, ?3, ?4);";
+
+static const char *SelectRunInfoSQL =
+  "SELECT config_hash, bitcode_hashes, shard_index, shard_count FROM run_info;";
+
+static const char *SelectReportedMutantsSQL =
+  "SELECT test.test_name, mutation_point.unique_id FROM mutation_execution "
+  "JOIN test ON test.id = mutation_execution.test_id "
+  "JOIN mutation_point ON mutation_point.id = mutation_execution.mutation_point_id;";
+
+static const char *InsertConfigSQL =
+  "INSERT INTO config VALUES "
+  "(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14);";
+
+/// A mutation point is killed when at least one test fails against it
+/// (Failed, Timedout, Crashed or AbnormalExit) and survives when every
+/// test passes. The score is killed / (killed + survived).
+static const char *WriteSummaries = R"WriteSummaries(
+DROP TABLE IF EXISTS temp.mutant_outcome;
+
+CREATE TEMP TABLE mutant_outcome AS
+SELECT
+  mutation_execution.mutation_point_id AS mutation_point_id,
+  MAX(execution.status IN (1, 3, 4, 5)) AS killed,
+  MIN(execution.status = 2) AS survived,
+  MIN(execution.status = 7) AS equivalent
+FROM mutation_execution
+JOIN execution
+  ON execution.id = mutation_execution.execution_result_id
+GROUP BY mutation_execution.mutation_point_id;
+
+DELETE FROM function_score;
+
+INSERT INTO function_score
+SELECT
+  mutation_point.filename,
+  mutation_point.function_name,
+  COUNT(*),
+  SUM(mutant_outcome.killed),
+  SUM(mutant_outcome.survived),
+  SUM(mutant_outcome.equivalent),
+  CAST(SUM(mutant_outcome.killed) AS REAL) /
+    NULLIF(SUM(mutant_outcome.killed) + SUM(mutant_outcome.survived), 0)
+FROM mutant_outcome
+JOIN mutation_point ON mutation_point.id = mutant_outcome.mutation_point_id
+GROUP BY mutation_point.filename, mutation_point.function_name;
+
+DELETE FROM file_score;
+
+INSERT INTO file_score
+SELECT
+  filename,
+  SUM(mutants),
+  SUM(killed),
+  SUM(survived),
+  SUM(equivalent),
+  CAST(SUM(killed) AS REAL) / NULLIF(SUM(killed) + SUM(survived), 0)
+FROM function_score
+GROUP BY filename;
+
+DROP TABLE temp.mutant_outcome;
+)WriteSummaries";
+
+/// Runs a 'SELECT id ...' statement, returns false if there is no such row
+static bool sqlite_select_id(sqlite3 *database, sqlite3_stmt *stmt,
+                             int64_t &id) {
+  int result = sqlite3_step(stmt);
+  if (result != SQLITE_ROW && result != SQLITE_DONE) {
+    Logger::error() << "Error selecting data: \n" << "\n";
+    Logger::error() << "Reason: '" << sqlite3_errmsg(database) << "'\n";
+    Logger::error() << "Shutting down\n";
+    exit(18);
+  }
+
+  bool found = result == SQLITE_ROW;
+  if (found) {
+    id = sqlite3_column_int64(stmt, 0);
+  }
+
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+  return found;
+}
+
+static int schemaVersion(sqlite3 *database) {
+  sqlite3_stmt *stmt = sqlite_prepare(database, "PRAGMA user_version;");
+  int version = 0;
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    version = sqlite3_column_int(stmt, 0);
+  }
+  sqlite3_finalize(stmt);
+  return version;
 }
 
 SQLiteReporter::SQLiteReporter(const std::string &projectName) {
@@ -84,179 +257,430 @@ SQLiteReporter::SQLiteReporter(const std::string &projectName) {
   std::string databasePath = currentDirectory + "/" + projectNameComponent + currentTime + ".sqlite";
 
   this->databasePath = databasePath;
+  this->database = nullptr;
+  this->insertExecutionStmt = nullptr;
+  this->selectOutputBlobStmt = nullptr;
+  this->insertOutputBlobStmt = nullptr;
+  this->selectTestStmt = nullptr;
+  this->insertTestStmt = nullptr;
+  this->selectMutationPointStmt = nullptr;
+  this->insertMutationPointStmt = nullptr;
+  this->insertMutationPointDebugStmt = nullptr;
+  this->insertMutationExecutionStmt = nullptr;
+  this->pendingRows = 0;
+  this->emitDebugInfo = false;
+  this->resuming = false;
+  this->keepOutputOnlyForKilledMutants = false;
+}
+
+SQLiteReporter::~SQLiteReporter() {
+  close();
+}
+
+/// Returns the blob as is when it has the original size, the way the
+/// sqlite3 shell does
+static void sqlarUncompress(sqlite3_context *context,
+                            int argc,
+                            sqlite3_value **argv) {
+  const char *data = (const char *)sqlite3_value_blob(argv[0]);
+  int dataSize = sqlite3_value_bytes(argv[0]);
+  sqlite3_int64 size = sqlite3_value_int64(argv[1]);
+
+  if (data == nullptr || dataSize == size) {
+    sqlite3_result_value(context, argv[0]);
+    return;
+  }
+
+  SmallString<0> output;
+  if (zlib::uncompress(StringRef(data, dataSize), output, size) !=
+      zlib::StatusOK) {
+    sqlite3_result_error(context, "sqlar_uncompress: corrupt data", -1);
+    return;
+  }
+
+  sqlite3_result_blob(context, output.data(), output.size(), SQLITE_TRANSIENT);
+}
+
+void SQLiteReporter::registerFunctions(sqlite3 *database) {
+  sqlite3_create_function(database, "sqlar_uncompress", 2,
+                          SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr,
+                          sqlarUncompress, nullptr, nullptr);
 }
 
 std::string mull::SQLiteReporter::getDatabasePath() {
   return databasePath;
 }
 
-void mull::SQLiteReporter::reportResults(const std::unique_ptr<Result> &result,
-                                         const Config &config,
-                                         const ResultTime &resultTime) {
+void SQLiteReporter::resumeFrom(const std::string &path) {
+  assert(database == nullptr && "Cannot resume after reporting has started");
+  databasePath = path;
+  resuming = true;
+}
 
-  std::string databasePath = getDatabasePath();
+void SQLiteReporter::open() {
+  if (database) {
+    return;
+  }
+
+  if (resuming && !sys::fs::exists(databasePath)) {
+    Logger::error() << "Cannot resume: " << databasePath << " does not exist\n";
+    exit(1);
+  }
 
-  sqlite3 *database;
   sqlite3_open(databasePath.c_str(), &database);
+  registerFunctions(database);
+
+  if (resuming && schemaVersion(database) != SchemaVersion) {
+    Logger::error() << "Cannot resume: " << databasePath
+                    << " was written by an incompatible version of Mull\n";
+    exit(1);
+  }
+
+  /// The report can be regenerated by rerunning Mull, so durability
+  /// of every single row is not worth an fsync per insert.
+  sqlite_exec(database, "PRAGMA journal_mode = WAL;");
+  sqlite_exec(database, "PRAGMA synchronous = NORMAL;");
 
   createTables(database);
 
-  for (auto &testResult : result->getTestResults()) {
-    std::string testID = testResult->getDisplayName();
-
-    ExecutionResult testExecutionResult = testResult->getOriginalTestResult();
-    std::string insertResultSQL = std::string("INSERT INTO execution_result VALUES (")
-      + "'" + std::to_string(testExecutionResult.status) + "',"
-      + "'" + std::to_string(testExecutionResult.runningTime) + "',"
-      + "" + "?1" + ","
-      + "" + "?2" + ");";
-    sqlite3_stmt *stmt;
-    sqlite3_prepare(database, insertResultSQL.c_str(), -1, &stmt, NULL);
-    sqlite3_bind_text(stmt, 1, testExecutionResult.stdoutOutput.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, testExecutionResult.stderrOutput.c_str(), -1, SQLITE_STATIC);
-    
-    sqlite_step(database, stmt);
-    
-    int testResultID = sqlite3_last_insert_rowid(database);
+  insertExecutionStmt = sqlite_prepare(database, InsertExecutionSQL);
+  selectOutputBlobStmt = sqlite_prepare(database, SelectOutputBlobSQL);
+  insertOutputBlobStmt = sqlite_prepare(database, InsertOutputBlobSQL);
+  selectTestStmt = sqlite_prepare(database, SelectTestSQL);
+  insertTestStmt = sqlite_prepare(database, InsertTestSQL);
+  selectMutationPointStmt = sqlite_prepare(database, SelectMutationPointSQL);
+  insertMutationPointStmt = sqlite_prepare(database, InsertMutationPointSQL);
+  insertMutationPointDebugStmt =
+    sqlite_prepare(database, InsertMutationPointDebugSQL);
+  insertMutationExecutionStmt =
+    sqlite_prepare(database, InsertMutationExecutionSQL);
 
-    std::string insertTestSQL = std::string("INSERT INTO test VALUES (")
-      + "'" + testID + "',"
-      + "'" + std::to_string(testResultID) + "');";
-    sqlite_exec(database, insertTestSQL.c_str());
+  if (resuming) {
+    loadReportedResults();
+  }
 
-    for (auto &mutation : testResult->getMutationResults()) {
+  sqlite_exec(database, "BEGIN TRANSACTION;");
+  pendingRows = 0;
+}
+
+void SQLiteReporter::close() {
+  if (!database) {
+    return;
+  }
+
+  sqlite_exec(database, "COMMIT TRANSACTION;");
+
+  sqlite3_finalize(insertExecutionStmt);
+  sqlite3_finalize(selectOutputBlobStmt);
+  sqlite3_finalize(insertOutputBlobStmt);
+  sqlite3_finalize(selectTestStmt);
+  sqlite3_finalize(insertTestStmt);
+  sqlite3_finalize(selectMutationPointStmt);
+  sqlite3_finalize(insertMutationPointStmt);
+  sqlite3_finalize(insertMutationPointDebugStmt);
+  sqlite3_finalize(insertMutationExecutionStmt);
+
+  sqlite3_close(database);
+  database = nullptr;
+}
+
+void SQLiteReporter::loadReportedResults() {
+  sqlite3_stmt *stmt = sqlite_prepare(database, SelectReportedMutantsSQL);
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    std::string testID((const char *)sqlite3_column_text(stmt, 0));
+    std::string mutationPointID((const char *)sqlite3_column_text(stmt, 1));
+    reportedMutants.insert(std::make_pair(testID, mutationPointID));
+  }
+  sqlite3_finalize(stmt);
 
-      /// Mutation Point
-      auto mutationPoint = mutation->getMutationPoint();
-      Instruction *instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
-
-      std::string fileNameOrNil = "no-debug-info";
-      std::string directoryOrNil = "no-debug-info";
-      std::string lineOrNil = "0";
-      std::string columnOrNil = "0";
-
-      if (instruction->getMetadata(0)) {
-        fileNameOrNil = instruction->getDebugLoc()->getFilename().str();
-        directoryOrNil = instruction->getDebugLoc()->getDirectory().str();
-        lineOrNil = std::to_string(instruction->getDebugLoc()->getLine());
-        columnOrNil = std::to_string(instruction->getDebugLoc()->getColumn());
-      }
-
-      std::string insertMutationPointSQL = std::string("INSERT OR IGNORE INTO mutation_point VALUES (")
-        + "'" + mutationPoint->getOperator()->uniqueID() + "',"
-        + "'" + instruction->getParent()->getParent()->getParent()->getModuleIdentifier() + "',"
-        + "'" + instruction->getParent()->getParent()->getName().str() + "',"
-        + "'" + std::to_string(mutationPoint->getAddress().getFnIndex()) + "',"
-        + "'" + std::to_string(mutationPoint->getAddress().getBBIndex()) + "',"
-        + "'" + std::to_string(mutationPoint->getAddress().getIIndex()) + "',"
-        + "'" + fileNameOrNil + "',"
-        + "'" + directoryOrNil + "',"
-        + "'" + mutationPoint->getDiagnostics() + "',"
-        + "'" + lineOrNil + "',"
-        + "'" + columnOrNil + "',"
-        + "'" + mutationPoint->getUniqueIdentifier() + "'"+
-        + ");";
-
-      sqlite_exec(database, insertMutationPointSQL.c_str());
-      std::string mutationPointID = mutationPoint->getUniqueIdentifier();
-
-      if (config.shouldEmitDebugInfo()) {
-        std::string function;
-        llvm::raw_string_ostream f_ostream(function);
-        instruction->getFunction()->print(f_ostream);
-
-        std::string basicBlock;
-        llvm::raw_string_ostream bb_ostream(basicBlock);
-        instruction->getParent()->print(bb_ostream);
-
-        std::string instr;
-        llvm::raw_string_ostream i_ostream(instr);
-        instruction->print(i_ostream);
-
-        std::string fileNameOrNil = "no-debug-info";
-        std::string lineOrNil = "0";
-        std::string columnOrNil = "0";
-
-        if (instruction->getMetadata(0)) {
-          fileNameOrNil = instruction->getDebugLoc()->getFilename().str();
-          lineOrNil = std::to_string(instruction->getDebugLoc()->getLine());
-          columnOrNil = std::to_string(instruction->getDebugLoc()->getColumn());
-        }
-
-        std::string insertMutationPointDebugSQL = std::string("INSERT OR IGNORE INTO mutation_point_debug VALUES (")
-        + "'" + fileNameOrNil + "',"
-        + "'" + lineOrNil + "',"
-        + "'" + columnOrNil + "',"
-        + "'" + f_ostream.str() + "',"
-        + "'" + bb_ostream.str() + "',"
-        + "'" + i_ostream.str() + "',"
-        + "'" + mutationPoint->getUniqueIdentifier() + "'"+
-        + ");";
-
-        sqlite3_stmt *statement = NULL;
-        int statement_prepare_result =
-        sqlite3_prepare_v2(database,
-                           insertMutationPointDebugSQL.c_str(),
-                           insertMutationPointDebugSQL.size(),
-                           &statement,
-                           NULL);
-
-        assume(statement_prepare_result == SQLITE_OK, "SQLite error: Expected finalize of debug mutation point statement to succeed.");
-
-        int insertion_result = sqlite3_step(statement);
-        assume(insertion_result == SQLITE_DONE, "SQLite error: Expected insertion of debug mutation point to succeed.");
-
-        int finalize_result = sqlite3_finalize(statement);
-        assume(finalize_result == SQLITE_OK, "SQLite error: Expected finalize of debug mutation point statement to succeed.");
-      }
-
-      /// Execution result
-      ExecutionResult mutationExecutionResult = mutation->getExecutionResult();
-      std::string insertMutationExecutionResultSQL = std::string("INSERT INTO execution_result VALUES (")
-        + "'" + std::to_string(mutationExecutionResult.status) + "',"
-        + "'" + std::to_string(mutationExecutionResult.runningTime) + "',"
-        + "" + "?" + ","
-        + "" + "?" + ");";
-
-      sqlite3_stmt *execution_result_statement = NULL;
-      int execution_result_statement_prepare_result =
-        sqlite3_prepare_v2(database,
-                           insertMutationExecutionResultSQL.c_str(),
-                           insertMutationExecutionResultSQL.size(),
-                           &execution_result_statement,
-                           NULL);
-
-      assume(execution_result_statement_prepare_result == SQLITE_OK,
-             "SQLite error: Expected preparation of execution result statement to succeed.");
-
-      if (execution_result_statement_prepare_result != SQLITE_OK) {
-        Logger::error() << insertMutationExecutionResultSQL << '\n';
-        Logger::error() << sqlite3_errmsg(database) << '\n';
-      }
-
-      sqlite3_bind_text(execution_result_statement, 1, mutationExecutionResult.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
-      sqlite3_bind_text(execution_result_statement, 2, mutationExecutionResult.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
-
-      int execution_result_insertion_result = sqlite3_step(execution_result_statement);
-      assume(execution_result_insertion_result == SQLITE_DONE,
-             "SQLite error: Expected insertion of execution result to succeed.");
-
-      int execution_result_statement_finalize_result
-        = sqlite3_finalize(execution_result_statement);
-      assume(execution_result_statement_finalize_result == SQLITE_OK,
-             "SQLite error: Expected finalize of execution result statement to succeed.");
-
-      int mutationExecutionResultID = sqlite3_last_insert_rowid(database);
-      std::string insertMutationResultSQL = std::string("INSERT INTO mutation_result VALUES (")
-          + "'" + std::to_string(mutationExecutionResultID) + "',"
-          + "'" + testID + "',"
-          + "'" + mutationPointID + "',"
-          + "'" + std::to_string(mutation->getMutationDistance()) + "'"
-          + ");";
-
-      sqlite_exec(database, insertMutationResultSQL.c_str());
+  Logger::debug() << "SQLiteReporter> resuming " << databasePath << ": "
+                  << reportedMutants.size() << " mutants already reported\n";
+}
+
+/// Commits every BatchSize rows: a crash loses at most one batch and
+/// the journal does not grow with the size of the run.
+void SQLiteReporter::rowInserted() {
+  pendingRows++;
+  if (pendingRows < BatchSize) {
+    return;
+  }
+
+  sqlite_exec(database, "COMMIT TRANSACTION;");
+  sqlite_exec(database, "BEGIN TRANSACTION;");
+  pendingRows = 0;
+}
+
+/// Hash of the options that decide which mutants are run against which
+/// tests. Options that only affect how they run are left out, so that
+/// e.g. the timeout can be tweaked before resuming.
+static std::string configHash(const Config &config) {
+  std::vector<std::string> operators = config.getMutationOperators();
+  std::sort(operators.begin(), operators.end());
+
+  return md5(config.getTestFramework() + ";" +
+             vectorToCsv(operators) + ";" +
+             vectorToCsv(config.getTests()) + ";" +
+             vectorToCsv(config.getExcludeLocations()) + ";" +
+             std::to_string(config.getMaxDistance()) + ";" +
+             std::to_string(config.isDryRun()) + ";" +
+             std::to_string(config.shouldDetectEquivalentMutants()));
+}
+
+void SQLiteReporter::begin(const Config &config,
+                           const std::vector<std::string> &bitcodeHashes) {
+  open();
+
+  std::vector<std::string> sortedBitcodeHashes(bitcodeHashes);
+  std::sort(sortedBitcodeHashes.begin(), sortedBitcodeHashes.end());
+
+  std::string currentConfigHash = configHash(config);
+  std::string currentBitcodeHashes = vectorToCsv(sortedBitcodeHashes);
+
+  bool recorded = false;
+  sqlite3_stmt *stmt = sqlite_prepare(database, SelectRunInfoSQL);
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    recorded = true;
+    std::string recordedConfigHash((const char *)sqlite3_column_text(stmt, 0));
+    std::string recordedBitcodeHashes((const char *)sqlite3_column_text(stmt, 1));
+
+    if (recordedConfigHash != currentConfigHash) {
+      Logger::error() << "Cannot resume " << databasePath
+                      << ": the config differs from the one of the interrupted run\n";
+      exit(1);
+    }
+
+    if (recordedBitcodeHashes != currentBitcodeHashes) {
+      Logger::error() << "Cannot resume " << databasePath
+                      << ": the bitcode differs from the one of the interrupted run\n";
+      exit(1);
     }
+
+    if (sqlite3_column_int(stmt, 2) != config.getShardIndex() ||
+        sqlite3_column_int(stmt, 3) != config.getShardCount()) {
+      Logger::error() << "Cannot resume " << databasePath
+                      << ": it holds the results of another shard\n";
+      exit(1);
+    }
+  }
+  sqlite3_finalize(stmt);
+
+  if (!recorded) {
+    stmt = sqlite_prepare(database, InsertRunInfoSQL);
+    sqlite_bind_text(stmt, 1, currentConfigHash);
+    sqlite_bind_text(stmt, 2, currentBitcodeHashes);
+    sqlite_bind_int(stmt, 3, config.getShardIndex());
+    sqlite_bind_int(stmt, 4, config.getShardCount());
+    sqlite_step(database, stmt);
+    sqlite3_finalize(stmt);
+  }
+}
+
+bool SQLiteReporter::isReported(TestResult &testResult,
+                                MutationPoint &mutationPoint) {
+  if (reportedMutants.empty()) {
+    return false;
+  }
+
+  auto key = std::make_pair(testResult.getDisplayName(),
+                            mutationPoint.getUniqueIdentifier());
+  return reportedMutants.count(key) != 0;
+}
+
+static bool isKillingStatus(ExecutionStatus status) {
+  return status == Failed || status == Timedout ||
+         status == Crashed || status == AbnormalExit;
+}
+
+/// Outputs are content addressed: identical outputs, like the banner most
+/// test frameworks print, are stored once.
+int64_t SQLiteReporter::insertOutput(const std::string &output) {
+  std::string hash = md5(output);
+
+  int64_t outputID;
+  sqlite_bind_text(selectOutputBlobStmt, 1, hash);
+  if (sqlite_select_id(database, selectOutputBlobStmt, outputID)) {
+    return outputID;
+  }
+
+  SmallString<0> compressedOutput;
+  bool compressed = false;
+  if (output.size() >= CompressionThreshold && zlib::isAvailable()) {
+    zlib::Status status = zlib::compress(output, compressedOutput);
+    compressed = status == zlib::StatusOK &&
+                 compressedOutput.size() < output.size();
+  }
+
+  StringRef data = compressed ? compressedOutput.str() : StringRef(output);
+
+  sqlite3_stmt *stmt = insertOutputBlobStmt;
+  sqlite_bind_text(stmt, 1, hash);
+  sqlite_bind_int(stmt, 2, output.size());
+  sqlite_bind_int(stmt, 3, compressed);
+  sqlite3_bind_blob(stmt, 4, data.data(), data.size(), SQLITE_TRANSIENT);
+  sqlite_step(database, stmt);
+
+  return sqlite3_last_insert_rowid(database);
+}
+
+int64_t SQLiteReporter::insertExecutionResult(const ExecutionResult &result,
+                                              bool keepOutput) {
+  sqlite3_stmt *stmt = insertExecutionStmt;
+  sqlite_bind_int(stmt, 1, result.status);
+  sqlite_bind_int(stmt, 2, result.runningTime);
+
+  if (keepOutput) {
+    sqlite_bind_int(stmt, 3, insertOutput(result.stdoutOutput));
+    sqlite_bind_int(stmt, 4, insertOutput(result.stderrOutput));
+  } else {
+    sqlite3_bind_null(stmt, 3);
+    sqlite3_bind_null(stmt, 4);
+  }
+
+  sqlite_step(database, stmt);
+  return sqlite3_last_insert_rowid(database);
+}
+
+int64_t SQLiteReporter::insertTest(TestResult &testResult) {
+  std::string testName = testResult.getDisplayName();
+
+  auto cached = testIDs.find(testName);
+  if (cached != testIDs.end()) {
+    return cached->second;
+  }
+
+  int64_t testID;
+  sqlite_bind_text(selectTestStmt, 1, testName);
+  if (!sqlite_select_id(database, selectTestStmt, testID)) {
+    int64_t testResultID =
+      insertExecutionResult(testResult.getOriginalTestResult(), true);
+
+    sqlite_bind_text(insertTestStmt, 1, testName);
+    sqlite_bind_int(insertTestStmt, 2, testResultID);
+    sqlite_bind_text(insertTestStmt, 3, testResult.getTestHash());
+    sqlite_step(database, insertTestStmt);
+    testID = sqlite3_last_insert_rowid(database);
+  }
+
+  testIDs.insert(std::make_pair(testName, testID));
+  return testID;
+}
+
+int64_t SQLiteReporter::insertMutationPoint(MutationPoint &mutationPoint,
+                                            const std::string &functionHash) {
+  std::string uniqueID = mutationPoint.getUniqueIdentifier();
+
+  int64_t mutationPointID;
+  sqlite_bind_text(selectMutationPointStmt, 1, uniqueID);
+  if (sqlite_select_id(database, selectMutationPointStmt, mutationPointID)) {
+    return mutationPointID;
+  }
+
+  const SourceLocation &location = mutationPoint.getSourceLocation();
+
+  std::string fileNameOrNil = "no-debug-info";
+  std::string directoryOrNil = "no-debug-info";
+  int lineOrNil = 0;
+  int columnOrNil = 0;
+
+  if (!location.isNull()) {
+    fileNameOrNil = location.fileName;
+    directoryOrNil = location.directory;
+    lineOrNil = location.line;
+    columnOrNil = location.column;
+  }
+
+  sqlite3_stmt *stmt = insertMutationPointStmt;
+  sqlite_bind_text(stmt, 1, mutationPoint.getOperator()->uniqueID());
+  sqlite_bind_text(stmt, 2, mutationPoint.getOriginalModule()->getModule()->getModuleIdentifier());
+  sqlite_bind_text(stmt, 3, mutationPoint.getFunctionName());
+  sqlite_bind_int(stmt, 4, mutationPoint.getAddress().getFnIndex());
+  sqlite_bind_int(stmt, 5, mutationPoint.getAddress().getBBIndex());
+  sqlite_bind_int(stmt, 6, mutationPoint.getAddress().getIIndex());
+  sqlite_bind_text(stmt, 7, fileNameOrNil);
+  sqlite_bind_text(stmt, 8, directoryOrNil);
+  sqlite_bind_text(stmt, 9, mutationPoint.getDiagnostics());
+  sqlite_bind_int(stmt, 10, lineOrNil);
+  sqlite_bind_int(stmt, 11, columnOrNil);
+  sqlite_bind_text(stmt, 12, uniqueID);
+  sqlite_bind_text(stmt, 13, functionHash);
+  sqlite_step(database, stmt);
+  mutationPointID = sqlite3_last_insert_rowid(database);
+
+  /// The bodies of the functions are kept when the debug info is emitted
+  if (emitDebugInfo) {
+    Instruction *instruction =
+      dyn_cast<Instruction>(mutationPoint.getOriginalValue());
+
+    std::string function;
+    llvm::raw_string_ostream f_ostream(function);
+    instruction->getFunction()->print(f_ostream);
+
+    std::string basicBlock;
+    llvm::raw_string_ostream bb_ostream(basicBlock);
+    instruction->getParent()->print(bb_ostream);
+
+    std::string instr;
+    llvm::raw_string_ostream i_ostream(instr);
+    instruction->print(i_ostream);
+
+    sqlite3_stmt *stmt = insertMutationPointDebugStmt;
+    sqlite_bind_int(stmt, 1, mutationPointID);
+    sqlite_bind_text(stmt, 2, fileNameOrNil);
+    sqlite_bind_int(stmt, 3, lineOrNil);
+    sqlite_bind_int(stmt, 4, columnOrNil);
+    sqlite_bind_text(stmt, 5, f_ostream.str());
+    sqlite_bind_text(stmt, 6, bb_ostream.str());
+    sqlite_bind_text(stmt, 7, i_ostream.str());
+    sqlite_bind_text(stmt, 8, uniqueID);
+    sqlite_step(database, stmt);
+  }
+
+  return mutationPointID;
+}
+
+void SQLiteReporter::reportTest(TestResult &testResult) {
+  open();
+
+  insertTest(testResult);
+
+  rowInserted();
+}
+
+void SQLiteReporter::reportMutant(TestResult &testResult,
+                                  MutationResult &mutation) {
+  open();
+
+  int64_t testID = insertTest(testResult);
+  int64_t mutationPointID = insertMutationPoint(*mutation.getMutationPoint(),
+                                                mutation.getFunctionHash());
+
+  ExecutionResult executionResult = mutation.getExecutionResult();
+  bool keepOutput = !keepOutputOnlyForKilledMutants ||
+                    isKillingStatus(executionResult.status);
+
+  int64_t mutationExecutionResultID =
+    insertExecutionResult(executionResult, keepOutput);
+
+  sqlite3_stmt *stmt = insertMutationExecutionStmt;
+  sqlite_bind_int(stmt, 1, mutationExecutionResultID);
+  sqlite_bind_int(stmt, 2, testID);
+  sqlite_bind_int(stmt, 3, mutationPointID);
+  sqlite_bind_int(stmt, 4, mutation.getMutationDistance());
+  if (mutation.getAliasOf()) {
+    sqlite_bind_int(stmt, 5, insertMutationPoint(*mutation.getAliasOf(),
+                                                 mutation.getFunctionHash()));
+  } else {
+    sqlite3_bind_null(stmt, 5);
   }
+  sqlite_step(database, stmt);
+
+  rowInserted();
+}
+
+void SQLiteReporter::finish(const Config &config,
+                            const ResultTime &resultTime) {
+  TraceScope scope("write report", "report");
+  open();
 
   /// Config
   {
@@ -265,54 +689,317 @@ void mull::SQLiteReporter::reportResults(const std::unique_ptr<Result> &result,
     const long startTime = resultTime.start;
     const long endTime = resultTime.end;
 
-    std::string csvBitcodePaths = vectorToCsv(config.getBitcodePaths());
-    std::string csvMutationOperators = vectorToCsv(config.getMutationOperators());
-    std::string csvDynamicLibraries = vectorToCsv(config.getDynamicLibrariesPaths());
-    std::string csvObjectFiles = vectorToCsv(config.getObjectFilesPaths());
-    std::string csvTests = vectorToCsv(config.getTests());
-
-    std::string insertConfigSQL = std::string("INSERT INTO config VALUES (")
-    + "'" + config.getProjectName() + "',"
-    + "'" + csvBitcodePaths + "',"
-    + "'" + csvMutationOperators + "',"
-    + "'" + csvDynamicLibraries + "',"
-    + "'" + csvObjectFiles + "',"
-    + "'" + csvTests + "',"
-    + "'" + std::to_string(config.getFork()) + "',"
-    + "'" + std::to_string(config.isDryRun()) + "',"
-    + "'" + std::to_string(config.getUseCache()) + "',"
-    + "'" + std::to_string(config.getTimeout()) + "',"
-    + "'" + std::to_string(config.getMaxDistance()) + "',"
-    + "'" + config.getCacheDirectory() + "'," +
-    + "'" + std::to_string(startTime) + "'," +
-    + "'" + std::to_string(endTime) + "'" +
-    ");"
-    ;
-
-    sqlite_exec(database, insertConfigSQL.c_str());
+    /// A resumed run replaces the config of the interrupted one
+    if (resuming) {
+      sqlite_exec(database, "DELETE FROM config;");
+    }
+
+    sqlite3_stmt *stmt = sqlite_prepare(database, InsertConfigSQL);
+    sqlite_bind_text(stmt, 1, config.getProjectName());
+    sqlite_bind_text(stmt, 2, vectorToCsv(config.getBitcodePaths()));
+    sqlite_bind_text(stmt, 3, vectorToCsv(config.getMutationOperators()));
+    sqlite_bind_text(stmt, 4, vectorToCsv(config.getDynamicLibrariesPaths()));
+    sqlite_bind_text(stmt, 5, vectorToCsv(config.getObjectFilesPaths()));
+    sqlite_bind_text(stmt, 6, vectorToCsv(config.getTests()));
+    sqlite_bind_int(stmt, 7, config.getFork());
+    sqlite_bind_int(stmt, 8, config.isDryRun());
+    sqlite_bind_int(stmt, 9, config.getUseCache());
+    sqlite_bind_int(stmt, 10, config.getTimeout());
+    sqlite_bind_int(stmt, 11, config.getMaxDistance());
+    sqlite_bind_text(stmt, 12, config.getCacheDirectory());
+    sqlite_bind_int(stmt, 13, startTime);
+    sqlite_bind_int(stmt, 14, endTime);
+    sqlite_step(database, stmt);
+    sqlite3_finalize(stmt);
   }
 
-  sqlite3_close(database);
+  sqlite_exec(database, WriteSummaries);
+
+  close();
 
   outs() << "Results can be found at '" << databasePath << "'\n";
 }
 
+void mull::SQLiteReporter::reportResults(const std::unique_ptr<Result> &result,
+                                         const Config &config,
+                                         const ResultTime &resultTime) {
+  setEmitDebugInfo(config.shouldEmitDebugInfo());
+  setKeepOutputOnlyForKilledMutants(config.getKeepOutput() == "killed");
+
+  for (auto &testResult : result->getTestResults()) {
+    reportTest(*testResult);
+
+    for (auto &mutation : testResult->getMutationResults()) {
+      reportMutant(*testResult, *mutation);
+    }
+  }
+
+  finish(config, resultTime);
+}
+
+#pragma mark - Merging
+
+/// Statements run for each shard attached as 'shard'. Executions keep their
+/// ids shifted by ?1, so that the references to them stay valid. Tests and
+/// mutation points are matched by their names and unique ids.
+
+static const char *MergeOutputBlobsSQL = R"SQL(
+INSERT OR IGNORE INTO main.output_blob (hash, size, compressed, data)
+SELECT hash, size, compressed, data FROM shard.output_blob;
+)SQL";
+
+static const char *MergeExecutionsSQL = R"SQL(
+INSERT INTO main.execution (id, status, duration, stdout_id, stderr_id)
+SELECT
+  shard_execution.id + ?1,
+  shard_execution.status,
+  shard_execution.duration,
+  (SELECT blob.id FROM shard.output_blob AS shard_blob
+   JOIN main.output_blob AS blob ON blob.hash = shard_blob.hash
+   WHERE shard_blob.id = shard_execution.stdout_id),
+  (SELECT blob.id FROM shard.output_blob AS shard_blob
+   JOIN main.output_blob AS blob ON blob.hash = shard_blob.hash
+   WHERE shard_blob.id = shard_execution.stderr_id)
+FROM shard.execution AS shard_execution;
+)SQL";
+
+static const char *MergeTestsSQL = R"SQL(
+INSERT OR IGNORE INTO main.test (test_name, execution_result_id, test_hash)
+SELECT test_name, execution_result_id + ?1, test_hash FROM shard.test;
+)SQL";
+
+static const char *MergeMutationPointsSQL = R"SQL(
+INSERT OR IGNORE INTO main.mutation_point (mutation_operator, module_name,
+  function_name, function_index, basic_block_index, instruction_index,
+  filename, directory, diagnostics, line_number, column_number, unique_id,
+  function_hash)
+SELECT mutation_operator, module_name, function_name, function_index,
+  basic_block_index, instruction_index, filename, directory, diagnostics,
+  line_number, column_number, unique_id, function_hash
+FROM shard.mutation_point;
+)SQL";
+
+static const char *MergeMutationPointsDebugSQL = R"SQL(
+INSERT OR IGNORE INTO main.mutation_point_debug (mutation_point_id, filename,
+  line_number, column_number, function, basic_block, instruction, unique_id)
+SELECT point.id, debug.filename, debug.line_number, debug.column_number,
+  debug.function, debug.basic_block, debug.instruction, point.unique_id
+FROM shard.mutation_point_debug AS debug
+JOIN shard.mutation_point AS shard_point
+  ON shard_point.id = debug.mutation_point_id
+JOIN main.mutation_point AS point ON point.unique_id = shard_point.unique_id;
+)SQL";
+
+static const char *MergeMutationExecutionsSQL = R"SQL(
+INSERT INTO main.mutation_execution (execution_result_id, test_id,
+  mutation_point_id, mutation_distance, alias_of_id)
+SELECT shard_execution.execution_result_id + ?1, test.id, point.id,
+  shard_execution.mutation_distance, alias.id
+FROM shard.mutation_execution AS shard_execution
+JOIN shard.test AS shard_test ON shard_test.id = shard_execution.test_id
+JOIN main.test AS test ON test.test_name = shard_test.test_name
+JOIN shard.mutation_point AS shard_point
+  ON shard_point.id = shard_execution.mutation_point_id
+JOIN main.mutation_point AS point ON point.unique_id = shard_point.unique_id
+LEFT JOIN shard.mutation_point AS shard_alias
+  ON shard_alias.id = shard_execution.alias_of_id
+LEFT JOIN main.mutation_point AS alias ON alias.unique_id = shard_alias.unique_id
+WHERE NOT EXISTS (
+  SELECT 1 FROM main.mutation_execution AS existing
+  WHERE existing.test_id = test.id AND existing.mutation_point_id = point.id
+);
+)SQL";
+
+/// Tests and mutants the output holds already keep their executions,
+/// the copies from the shard are dropped
+static const char *DeleteUnusedExecutionsSQL = R"SQL(
+DELETE FROM main.execution
+WHERE id > ?1
+  AND id NOT IN (SELECT execution_result_id FROM main.test)
+  AND id NOT IN (SELECT execution_result_id FROM main.mutation_execution);
+)SQL";
+
+/// The merged run started with the first shard and ended with the last one
+static const char *MergeConfigSQL = R"SQL(
+INSERT INTO main.config SELECT * FROM shard.config
+WHERE NOT EXISTS (SELECT 1 FROM main.config);
+
+UPDATE main.config SET
+  time_start = MIN(time_start,
+                   IFNULL((SELECT MIN(time_start) FROM shard.config), time_start)),
+  time_end = MAX(time_end,
+                 IFNULL((SELECT MAX(time_end) FROM shard.config), time_end));
+)SQL";
+
+static void mergeShard(sqlite3 *database, const char *sql, int64_t offset) {
+  sqlite3_stmt *stmt = sqlite_prepare(database, sql);
+  sqlite_bind_int(stmt, 1, offset);
+  sqlite_step(database, stmt);
+  sqlite3_finalize(stmt);
+}
+
+void SQLiteReporter::mergeDatabases(const std::string &outputPath,
+                                    const std::vector<std::string> &inputPaths) {
+  sqlite3 *database;
+  sqlite3_open(outputPath.c_str(), &database);
+  registerFunctions(database);
+  sqlite_exec(database, "PRAGMA journal_mode = WAL;");
+  sqlite_exec(database, "PRAGMA synchronous = NORMAL;");
+  createTables(database);
+
+  std::string configHash;
+  std::string bitcodeHashes;
+  int shardCount = 0;
+  std::set<int> shardIndices;
+
+  /// The output of an earlier merge only takes shards of the same run
+  sqlite3_stmt *runInfo = sqlite_prepare(database, SelectRunInfoSQL);
+  if (sqlite3_step(runInfo) == SQLITE_ROW) {
+    configHash = (const char *)sqlite3_column_text(runInfo, 0);
+    bitcodeHashes = (const char *)sqlite3_column_text(runInfo, 1);
+  }
+  sqlite3_finalize(runInfo);
+
+  for (const std::string &inputPath : inputPaths) {
+    if (!sys::fs::exists(inputPath)) {
+      Logger::error() << "Cannot merge: " << inputPath << " does not exist\n";
+      exit(1);
+    }
+
+    sqlite3_stmt *stmt = sqlite_prepare(database, "ATTACH DATABASE ?1 AS shard;");
+    sqlite_bind_text(stmt, 1, inputPath);
+    sqlite_step(database, stmt);
+    sqlite3_finalize(stmt);
+
+    stmt = sqlite_prepare(database, "PRAGMA shard.user_version;");
+    int version = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+    sqlite3_finalize(stmt);
+
+    if (version != SchemaVersion) {
+      Logger::error() << "Cannot merge: " << inputPath
+                      << " was written by an incompatible version of Mull\n";
+      exit(1);
+    }
+
+    stmt = sqlite_prepare(database,
+                          "SELECT config_hash, bitcode_hashes, shard_index, "
+                          "shard_count FROM shard.run_info;");
+    if (sqlite3_step(stmt) != SQLITE_ROW) {
+      Logger::error() << "Cannot merge: " << inputPath
+                      << " does not describe its run\n";
+      exit(1);
+    }
+
+    std::string shardConfigHash((const char *)sqlite3_column_text(stmt, 0));
+    std::string shardBitcodeHashes((const char *)sqlite3_column_text(stmt, 1));
+    int shardIndex = sqlite3_column_int(stmt, 2);
+    int shardCountOfInput = sqlite3_column_int(stmt, 3);
+    sqlite3_finalize(stmt);
+
+    if (configHash.empty()) {
+      configHash = shardConfigHash;
+      bitcodeHashes = shardBitcodeHashes;
+    }
+    if (shardCount == 0) {
+      shardCount = shardCountOfInput;
+    }
+    if (configHash != shardConfigHash ||
+        bitcodeHashes != shardBitcodeHashes ||
+        shardCount != shardCountOfInput) {
+      Logger::error() << "Cannot merge: " << inputPath
+                      << " comes from a run with another config or bitcode\n";
+      exit(1);
+    }
+
+    if (!shardIndices.insert(shardIndex).second) {
+      Logger::warn() << "mergeDatabases> shard " << shardIndex
+                     << " is merged more than once\n";
+    }
+
+    sqlite_exec(database, "BEGIN TRANSACTION;");
+
+    int64_t offset = 0;
+    stmt = sqlite_prepare(database, "SELECT IFNULL(MAX(id), 0) FROM main.execution;");
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+      offset = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+
+    mergeShard(database, MergeOutputBlobsSQL, offset);
+    mergeShard(database, MergeExecutionsSQL, offset);
+    mergeShard(database, MergeTestsSQL, offset);
+    mergeShard(database, MergeMutationPointsSQL, offset);
+    mergeShard(database, MergeMutationPointsDebugSQL, offset);
+    mergeShard(database, MergeMutationExecutionsSQL, offset);
+    mergeShard(database, DeleteUnusedExecutionsSQL, offset);
+    sqlite_exec(database, MergeConfigSQL);
+
+    sqlite_exec(database, "COMMIT TRANSACTION;");
+    sqlite_exec(database, "DETACH DATABASE shard;");
+
+    Logger::debug() << "mergeDatabases> merged shard " << shardIndex
+                    << " from " << inputPath << "\n";
+  }
+
+  if ((int)shardIndices.size() != shardCount) {
+    Logger::warn() << "mergeDatabases> merged " << shardIndices.size()
+                   << " of " << shardCount << " shards\n";
+  }
+
+  /// The merged database describes the whole run
+  sqlite_exec(database, "DELETE FROM run_info;");
+  sqlite3_stmt *stmt = sqlite_prepare(database, InsertRunInfoSQL);
+  sqlite_bind_text(stmt, 1, configHash);
+  sqlite_bind_text(stmt, 2, bitcodeHashes);
+  sqlite_bind_int(stmt, 3, 0);
+  sqlite_bind_int(stmt, 4, 1);
+  sqlite_step(database, stmt);
+  sqlite3_finalize(stmt);
+
+  sqlite_exec(database, WriteSummaries);
+
+  sqlite3_close(database);
+
+  outs() << "Results can be found at '" << outputPath << "'\n";
+}
+
 #pragma mark - Database Schema
 
+/// Tables reference each other by integer keys. The mutation_result view
+/// provides the layout of the old mutation_result table, with tests and
+/// mutation points referenced by their names. mutation_point_debug keeps
+/// the unique_id column of its old layout next to the integer key.
+/// Outputs are stored in output_blob, zlib-compressed when they are larger
+/// than CompressionThreshold. The execution_result view provides the layout
+/// of the old table in plain SQL: the execution id doubles as its rowid, and
+/// the outputs stored compressed read as NULL. The execution_output view has
+/// every output in full and needs sqlar_uncompress, see registerFunctions.
 static const char *CreateTables = R"CreateTables(
-CREATE TABLE execution_result (
+CREATE TABLE IF NOT EXISTS output_blob (
+  id INTEGER PRIMARY KEY,
+  hash TEXT UNIQUE,
+  size INT,
+  compressed INT,
+  data BLOB
+);
+
+CREATE TABLE IF NOT EXISTS execution (
+  id INTEGER PRIMARY KEY,
   status INT,
   duration INT,
-  stdout TEXT,
-  stderr TEXT
+  stdout_id INT REFERENCES output_blob(id),
+  stderr_id INT REFERENCES output_blob(id)
 );
 
-CREATE TABLE test (
-  test_name TEXT,
-  execution_result_id INT
+CREATE TABLE IF NOT EXISTS test (
+  id INTEGER PRIMARY KEY,
+  test_name TEXT UNIQUE,
+  execution_result_id INT REFERENCES execution(id),
+  test_hash TEXT
 );
 
-CREATE TABLE mutation_point (
+CREATE TABLE IF NOT EXISTS mutation_point (
+  id INTEGER PRIMARY KEY,
   mutation_operator TEXT,
   module_name TEXT,
   function_name TEXT,
@@ -324,27 +1011,57 @@ CREATE TABLE mutation_point (
   diagnostics TEXT,
   line_number INT,
   column_number INT,
-  unique_id TEXT UNIQUE
+  unique_id TEXT UNIQUE,
+  function_hash TEXT
 );
 
-CREATE TABLE mutation_result (
-  execution_result_id INT,
-  test_id TEXT,
-  mutation_point_id TEXT,
-  mutation_distance INT
+CREATE TABLE IF NOT EXISTS mutation_execution (
+  id INTEGER PRIMARY KEY,
+  execution_result_id INT REFERENCES execution(id),
+  test_id INT REFERENCES test(id),
+  mutation_point_id INT REFERENCES mutation_point(id),
+  mutation_distance INT,
+  alias_of_id INT REFERENCES mutation_point(id)
 );
 
-CREATE TABLE mutation_point_debug (
+CREATE TABLE IF NOT EXISTS mutation_point_debug (
+  mutation_point_id INTEGER PRIMARY KEY REFERENCES mutation_point(id),
   filename TEXT,
   line_number INT,
   column_number INT,
   function TEXT,
   basic_block TEXT,
-  instruction INT,
+  instruction TEXT,
   unique_id TEXT UNIQUE
 );
 
-CREATE TABLE config (
+CREATE TABLE IF NOT EXISTS function_score (
+  filename TEXT,
+  function_name TEXT,
+  mutants INT,
+  killed INT,
+  survived INT,
+  equivalent INT,
+  score REAL
+);
+
+CREATE TABLE IF NOT EXISTS file_score (
+  filename TEXT,
+  mutants INT,
+  killed INT,
+  survived INT,
+  equivalent INT,
+  score REAL
+);
+
+CREATE TABLE IF NOT EXISTS run_info (
+  config_hash TEXT,
+  bitcode_hashes TEXT,
+  shard_index INT,
+  shard_count INT
+);
+
+CREATE TABLE IF NOT EXISTS config (
   project_name TEXT,
   bitcode_paths TEXT,
   mutation_operators TEXT,
@@ -360,8 +1077,58 @@ CREATE TABLE config (
   time_start INT,
   time_end INT
 );
+
+CREATE INDEX IF NOT EXISTS mutation_execution_by_mutation_point
+  ON mutation_execution (mutation_point_id, execution_result_id, test_id);
+
+CREATE INDEX IF NOT EXISTS mutation_execution_by_test
+  ON mutation_execution (test_id, mutation_point_id);
+
+CREATE INDEX IF NOT EXISTS mutation_point_by_location
+  ON mutation_point (filename, function_name, line_number);
+
+CREATE VIEW IF NOT EXISTS execution_result AS
+SELECT
+  execution.id AS rowid,
+  execution.id AS id,
+  execution.status AS status,
+  execution.duration AS duration,
+  CASE WHEN stdout_blob.compressed THEN NULL
+       ELSE IFNULL(CAST(stdout_blob.data AS TEXT), '') END AS stdout,
+  CASE WHEN stderr_blob.compressed THEN NULL
+       ELSE IFNULL(CAST(stderr_blob.data AS TEXT), '') END AS stderr
+FROM execution
+LEFT JOIN output_blob AS stdout_blob ON stdout_blob.id = execution.stdout_id
+LEFT JOIN output_blob AS stderr_blob ON stderr_blob.id = execution.stderr_id;
+
+CREATE VIEW IF NOT EXISTS execution_output AS
+SELECT
+  execution.id AS execution_id,
+  IFNULL(CAST(sqlar_uncompress(stdout_blob.data, stdout_blob.size) AS TEXT),
+         '') AS stdout,
+  IFNULL(CAST(sqlar_uncompress(stderr_blob.data, stderr_blob.size) AS TEXT),
+         '') AS stderr
+FROM execution
+LEFT JOIN output_blob AS stdout_blob ON stdout_blob.id = execution.stdout_id
+LEFT JOIN output_blob AS stderr_blob ON stderr_blob.id = execution.stderr_id;
+
+CREATE VIEW IF NOT EXISTS mutation_result AS
+SELECT
+  mutation_execution.execution_result_id AS execution_result_id,
+  test.test_name AS test_id,
+  mutation_point.unique_id AS mutation_point_id,
+  mutation_execution.mutation_distance AS mutation_distance,
+  alias.unique_id AS alias_of
+FROM mutation_execution
+JOIN test ON test.id = mutation_execution.test_id
+JOIN mutation_point ON mutation_point.id = mutation_execution.mutation_point_id
+LEFT JOIN mutation_point AS alias ON alias.id = mutation_execution.alias_of_id;
 )CreateTables";
 
 static void createTables(sqlite3 *database) {
   sqlite_exec(database, CreateTables);
+
+  std::string setVersionSQL =
+    "PRAGMA user_version = " + std::to_string(SQLiteReporter::SchemaVersion) + ";";
+  sqlite_exec(database, setVersionSQL.c_str());
 }
@@ -0,0 +1,69 @@
+#include "ShardPartition.h"
+
+#include "Logger.h"
+#include "MutationPoint.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace mull;
+
+ShardPartition::ShardPartition(int shardIndex, int shardCount)
+  : shardIndex(shardIndex), shardCount(shardCount) {
+  assert(shardCount > 0 && "Expected at least one shard");
+  assert(shardIndex >= 0 && shardIndex < shardCount && "Invalid shard index");
+}
+
+void ShardPartition::addMutant(MutationPoint *mutationPoint) {
+  costs[mutationPoint] += 1;
+}
+
+void ShardPartition::partition() {
+  struct Mutant {
+    MutationPoint *point;
+    std::string identifier;
+    uint64_t cost;
+  };
+
+  std::vector<Mutant> mutants;
+  for (auto &cost : costs) {
+    mutants.push_back({ cost.first,
+                        cost.first->getUniqueIdentifier(),
+                        cost.second });
+  }
+
+  /// Pointers differ between the shards, identifiers don't
+  std::sort(mutants.begin(), mutants.end(),
+            [](const Mutant &lhs, const Mutant &rhs) {
+              if (lhs.cost != rhs.cost) {
+                return lhs.cost > rhs.cost;
+              }
+              return lhs.identifier < rhs.identifier;
+            });
+
+  std::vector<uint64_t> loads(shardCount, 0);
+  uint64_t ownLoad = 0;
+
+  for (Mutant &mutant : mutants) {
+    int leastLoaded =
+      std::min_element(loads.begin(), loads.end()) - loads.begin();
+    loads[leastLoaded] += mutant.cost;
+
+    if (leastLoaded == shardIndex) {
+      ownMutants.insert(mutant.point);
+      ownLoad += mutant.cost;
+    }
+  }
+
+  Logger::debug() << "ShardPartition> shard " << shardIndex + 1 << "/"
+                  << shardCount << ": " << ownMutants.size() << " of "
+                  << mutants.size() << " mutants, " << ownLoad
+                  << " test runs\n";
+}
+
+bool ShardPartition::contains(MutationPoint *mutationPoint) const {
+  if (!isSharded()) {
+    return true;
+  }
+  return ownMutants.count(mutationPoint) != 0;
+}
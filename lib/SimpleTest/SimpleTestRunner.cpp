@@ -3,10 +3,11 @@
 /// TODO: enable back for LLVM 4.0
 //#include "llvm/ExecutionEngine/JITSymbol.h"
 #include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
-#include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/Support/DynamicLibrary.h>
 
 #include "SimpleTest/SimpleTest_Test.h"
+#include "Tracer.h"
+#include "SymbolCache.h"
 
 using namespace mull;
 using namespace llvm;
@@ -15,7 +16,7 @@ class Mull_SimpleTest_Resolver : public RuntimeDyld::SymbolResolver {
 public:
 
   RuntimeDyld::SymbolInfo findSymbol(const std::string &Name) {
-    if (auto address = RTDyldMemoryManager::getSymbolAddressInProcess(Name)) {
+    if (auto address = SymbolCache::getSymbolAddress(Name)) {
       return RuntimeDyld::SymbolInfo(address, JITSymbolFlags::Exported);
     }
 
@@ -51,17 +52,66 @@ ExecutionStatus SimpleTestRunner::runTest(Test *test, ObjectFiles &objectFiles)
 
   SimpleTest_Test *SimpleTest = dyn_cast<SimpleTest_Test>(test);
 
+  TraceScope link("link", "runner");
   auto Handle = ObjectLayer.addObjectSet(objectFiles,
-                                         make_unique<SectionMemoryManager>(),
+                                         &memoryManager,
                                          make_unique<Mull_SimpleTest_Resolver>());
   void *FunctionPointer = TestFunctionPointer(*SimpleTest->GetTestFunction());
+  link.finish();
 
-  uint64_t result = ((int (*)())(intptr_t)FunctionPointer)();
+  uint64_t result = 0;
+  {
+    TraceScope scope("execute test", "runner");
+    result = ((int (*)())(intptr_t)FunctionPointer)();
+  }
 
   ObjectLayer.removeObjectSet(Handle);
+  memoryManager.reset();
 
   if (result == 1) {
     return ExecutionStatus::Passed;
   }
   return ExecutionStatus::Failed;
 }
+
+ExecutionStatus SimpleTestRunner::runTests(std::vector<Test *> &tests,
+                                           TestRunner::ObjectFiles &objectFiles) {
+  linkObjectFiles(objectFiles);
+  ExecutionStatus status = runLinkedTests(tests);
+  unlinkObjectFiles();
+
+  return status;
+}
+
+void SimpleTestRunner::linkObjectFiles(TestRunner::ObjectFiles &objectFiles) {
+  TraceScope link("link", "runner");
+  linkedObjects = ObjectLayer.addObjectSet(objectFiles,
+                                           &memoryManager,
+                                           make_unique<Mull_SimpleTest_Resolver>());
+  ObjectLayer.emitAndFinalize(linkedObjects);
+}
+
+void SimpleTestRunner::unlinkObjectFiles() {
+  ObjectLayer.removeObjectSet(linkedObjects);
+  memoryManager.reset();
+}
+
+ExecutionStatus SimpleTestRunner::runLinkedTests(std::vector<Test *> &tests) {
+  TraceScope execution("execute tests", "runner");
+  bool passed = true;
+  for (Test *test : tests) {
+    SimpleTest_Test *SimpleTest = dyn_cast<SimpleTest_Test>(test);
+    assert(SimpleTest && "Supposed to work only with SimpleTest tests");
+
+    void *FunctionPointer = TestFunctionPointer(*SimpleTest->GetTestFunction());
+    if (((int (*)())(intptr_t)FunctionPointer)() != 1) {
+      passed = false;
+    }
+  }
+  execution.finish();
+
+  if (passed) {
+    return ExecutionStatus::Passed;
+  }
+  return ExecutionStatus::Failed;
+}
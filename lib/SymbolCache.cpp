@@ -0,0 +1,92 @@
+#include "SymbolCache.h"
+
+#include "Logger.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
+#include <llvm/Object/ObjectFile.h>
+
+using namespace mull;
+using namespace llvm;
+using namespace llvm::object;
+
+static StringMap<uint64_t> addresses;
+static std::vector<std::string> cachedForLibraries;
+static StringMap<uint64_t> definitions;
+
+uint64_t SymbolCache::getSymbolAddress(const std::string &name) {
+  auto defined = definitions.find(name);
+  if (defined != definitions.end()) {
+    return defined->second;
+  }
+
+  auto cached = addresses.find(name);
+  if (cached != addresses.end()) {
+    return cached->second;
+  }
+
+  uint64_t address = RTDyldMemoryManager::getSymbolAddressInProcess(name);
+  if (address) {
+    addresses[name] = address;
+  }
+  return address;
+}
+
+void SymbolCache::define(const std::string &name, uint64_t address) {
+  definitions[name] = address;
+}
+
+void SymbolCache::prefetch(const std::vector<ObjectFile *> &objectFiles,
+                           const std::vector<std::string> &dynamicLibraries) {
+  if (dynamicLibraries != cachedForLibraries) {
+    addresses.clear();
+    cachedForLibraries = dynamicLibraries;
+  }
+
+  size_t resolved = 0;
+  size_t unresolved = 0;
+
+  for (ObjectFile *objectFile : objectFiles) {
+    for (const SymbolRef &symbol : objectFile->symbols()) {
+      if ((symbol.getFlags() & SymbolRef::SF_Undefined) == 0) {
+        continue;
+      }
+
+      Expected<StringRef> name = symbol.getName();
+      if (!name) {
+        consumeError(name.takeError());
+        continue;
+      }
+      if (name->empty()) {
+        continue;
+      }
+
+      if (addresses.count(*name) || definitions.count(*name)) {
+        continue;
+      }
+
+      uint64_t address =
+        RTDyldMemoryManager::getSymbolAddressInProcess(name->str());
+      addresses[*name] = address;
+      if (address) {
+        resolved++;
+      } else {
+        unresolved++;
+      }
+    }
+  }
+
+  Logger::debug() << "SymbolCache> resolved " << resolved
+                  << " symbols ahead of time, " << unresolved
+                  << " are not in the process\n";
+}
+
+size_t SymbolCache::size() {
+  return addresses.size();
+}
+
+void SymbolCache::clear() {
+  addresses.clear();
+  cachedForLibraries.clear();
+  definitions.clear();
+}
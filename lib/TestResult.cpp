@@ -5,8 +5,9 @@ using namespace mull;
 
 MutationResult::MutationResult(ExecutionResult R,
                                MutationPoint *MP,
-                               int distance) :
-  Result(R), MutPoint(MP), distance(distance)  {}
+                               int distance,
+                               MutationPoint *aliasOf) :
+  Result(R), MutPoint(MP), distance(distance), aliasOf(aliasOf)  {}
 
 TestResult::TestResult(ExecutionResult OriginalResult,
                        std::unique_ptr<Test> T) :
@@ -24,6 +25,10 @@ std::string TestResult::getDisplayName() {
   return TestPtr->getTestDisplayName();
 }
 
+Test *TestResult::getTest() {
+  return TestPtr.get();
+}
+
 std::vector<std::unique_ptr<MutationResult>> &TestResult::getMutationResults() {
   return MutationResults;
 }
@@ -0,0 +1,75 @@
+#include "Toolchain/CodegenProfile.h"
+
+using namespace mull;
+
+/// A test running this many times longer than the compilation makes the
+/// optimized code worth its longer compilation
+static const long long OptimizedTestToCompileRatio = 10;
+
+/// Compilations with the other profiles between two with the default one
+static const int DefaultSamplingInterval = 16;
+
+CodegenProfile mull::codegenProfileFromString(const std::string &name) {
+  if (name == "fast") {
+    return CodegenProfile::Fast;
+  }
+  if (name == "optimized") {
+    return CodegenProfile::Optimized;
+  }
+  return CodegenProfile::Default;
+}
+
+CodegenProfileSelector::CodegenProfileSelector(const std::string &name)
+  : automatic(name == "auto"),
+    profile(codegenProfileFromString(name)),
+    compileTimes{ 0, 0, 0 },
+    compiles{ 0, 0, 0 },
+    compilesSinceDefault(0)
+{
+}
+
+CodegenProfile CodegenProfileSelector::select(long long testTime) const {
+  if (!automatic) {
+    return profile;
+  }
+
+  /// Nothing to compare against until an object is compiled with the
+  /// default profile, and the comparison goes stale without new samples
+  if (compiles[static_cast<int>(CodegenProfile::Default)] == 0 ||
+      compilesSinceDefault >= DefaultSamplingInterval) {
+    return CodegenProfile::Default;
+  }
+
+  long long compileTime = averageCompileTime(CodegenProfile::Default);
+
+  if (testTime < compileTime) {
+    return CodegenProfile::Fast;
+  }
+
+  if (testTime > compileTime * OptimizedTestToCompileRatio) {
+    return CodegenProfile::Optimized;
+  }
+
+  return CodegenProfile::Default;
+}
+
+void CodegenProfileSelector::addCompileTime(CodegenProfile usedProfile,
+                                            long long compileTime) {
+  compileTimes[static_cast<int>(usedProfile)] += compileTime;
+  compiles[static_cast<int>(usedProfile)]++;
+
+  if (usedProfile == CodegenProfile::Default) {
+    compilesSinceDefault = 0;
+  } else {
+    compilesSinceDefault++;
+  }
+}
+
+long long
+CodegenProfileSelector::averageCompileTime(CodegenProfile usedProfile) const {
+  int index = static_cast<int>(usedProfile);
+  if (compiles[index] == 0) {
+    return 0;
+  }
+  return compileTimes[index] / compiles[index];
+}
@@ -3,7 +3,10 @@
 #include "MullModule.h"
 
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Transforms/Scalar.h"
 
 using namespace llvm;
 using namespace llvm::object;
@@ -14,17 +17,64 @@ Compiler::Compiler(TargetMachine &machine) :
 {
 }
 
-OwningBinary<ObjectFile> Compiler::compileModule(const MullModule &module) {
-  return compileModule(module.getModule());
+static void optimizeModule(Module &module) {
+  legacy::FunctionPassManager passManager(&module);
+  passManager.add(createPromoteMemoryToRegisterPass());
+  passManager.add(createSROAPass());
+  passManager.add(createEarlyCSEPass());
+  passManager.add(createInstructionCombiningPass());
+  passManager.add(createCFGSimplificationPass());
+  passManager.add(createLICMPass());
+  passManager.add(createGVNPass());
+  passManager.add(createInstructionCombiningPass());
+  passManager.add(createAggressiveDCEPass());
+  passManager.add(createCFGSimplificationPass());
+
+  passManager.doInitialization();
+  for (Function &function : module) {
+    if (function.isDeclaration()) {
+      continue;
+    }
+
+    /// The bitcode is normally built with -O0, which marks every function
+    /// as optnone, no pass or code generator would optimize it otherwise
+    function.removeFnAttr(Attribute::OptimizeNone);
+    passManager.run(function);
+  }
+  passManager.doFinalization();
 }
 
-OwningBinary<ObjectFile> Compiler::compileModule(Module *module) {
+OwningBinary<ObjectFile> Compiler::compileModule(const MullModule &module,
+                                                 CodegenProfile profile) {
+  return compileModule(module.getModule(), profile);
+}
+
+OwningBinary<ObjectFile> Compiler::compileModule(Module *module,
+                                                 CodegenProfile profile) {
   assert(module);
 
   if (module->getDataLayout().isDefault()) {
     module->setDataLayout(targetMachine.createDataLayout());
   }
 
+  /// The target machine is shared, so every profile sets both options.
+  /// At -O0 the instruction selector falls back to the fast scheduler.
+  switch (profile) {
+    case CodegenProfile::Fast:
+      targetMachine.setOptLevel(CodeGenOpt::None);
+      targetMachine.setFastISel(true);
+      break;
+    case CodegenProfile::Default:
+      targetMachine.setOptLevel(CodeGenOpt::Default);
+      targetMachine.setFastISel(false);
+      break;
+    case CodegenProfile::Optimized:
+      optimizeModule(*module);
+      targetMachine.setOptLevel(CodeGenOpt::Aggressive);
+      targetMachine.setFastISel(false);
+      break;
+  }
+
   orc::SimpleCompiler compiler(targetMachine);
 
   OwningBinary<ObjectFile> objectFile = compiler(*module);
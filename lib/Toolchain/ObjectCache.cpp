@@ -4,6 +4,7 @@
 #include "MullModule.h"
 #include "MutationPoint.h"
 
+#include <cassert>
 #include <dirent.h>
 #include <sys/stat.h>
 
@@ -28,8 +29,11 @@ static bool cacheDirectoryExists(const std::string &path) {
   return false;
 }
 
-ObjectCache::ObjectCache(bool useCache, const std::string &cacheDir)
-  : useOnDiskCache(useCache),
+ObjectCache::ObjectCache(bool useCache, const std::string &cacheDir,
+                         uint64_t mutantCacheSize)
+  : mutantObjectsSize(0),
+    mutantObjectsBudget(mutantCacheSize),
+    useOnDiskCache(useCache),
     cacheDirectory(cacheDir)
 {
   if (useOnDiskCache) {
@@ -47,68 +51,172 @@ ObjectCache::ObjectCache(bool useCache, const std::string &cacheDir)
   }
 }
 
-ObjectFile *ObjectCache::getObjectFromMemory(const std::string &identifier) {
-  if (inMemoryCache.count(identifier) != 0) {
-    auto &owningObject = inMemoryCache.at(identifier);
-    return owningObject.getBinary();
-  }
+bool ObjectCache::ObjectKey::operator==(const ObjectKey &other) const {
+  return module == other.module &&
+    mutationOperator == other.mutationOperator &&
+    functionIndex == other.functionIndex &&
+    basicBlockIndex == other.basicBlockIndex &&
+    instructionIndex == other.instructionIndex &&
+    profile == other.profile &&
+    onDemand == other.onDemand &&
+    dispatchedMutants == other.dispatchedMutants;
+}
 
-  return nullptr;
+ObjectCache::ObjectKey ObjectCache::moduleKey(const MullModule &module,
+                                              CodegenProfile profile,
+                                              bool onDemand) {
+  return { module.getIdentifierHash(), &module, nullptr, -1, -1, -1,
+           profile, onDemand, {} };
 }
 
-ObjectFile *ObjectCache::getObjectFromDisk(const std::string &identifier) {
-  if (!useOnDiskCache) {
-    return nullptr;
+ObjectCache::ObjectKey
+ObjectCache::mutantKey(const MutationPoint &mutationPoint,
+                       CodegenProfile profile,
+                       bool onDemand) {
+  MutationPointAddress address = mutationPoint.getAddress();
+  return { mutationPoint.getIdentifierHash(),
+           mutationPoint.getOriginalModule(),
+           mutationPoint.getOperator(),
+           address.getFnIndex(),
+           address.getBBIndex(),
+           address.getIIndex(),
+           profile,
+           onDemand,
+           {} };
+}
+
+ObjectCache::ObjectKey
+ObjectCache::dispatchKey(const std::vector<MutationPoint *> &mutationPoints,
+                         CodegenProfile profile) {
+  assert(!mutationPoints.empty() && "A dispatch object needs mutants");
+
+  MullModule *module = mutationPoints.front()->getOriginalModule();
+  ObjectKey key = { module->getIdentifierHash(), module, nullptr,
+                    mutationPoints.front()->getAddress().getFnIndex(), -1, -1,
+                    profile, false, {} };
+  for (MutationPoint *mutationPoint : mutationPoints) {
+    key.identifierHash = key.identifierHash * 31 +
+      mutationPoint->getIdentifierHash();
+    key.dispatchedMutants.push_back(mutationPoint);
   }
+  return key;
+}
+
+static std::string cacheName(const std::string &identifier,
+                             CodegenProfile profile,
+                             bool onDemand) {
+  return identifier + "_" + std::to_string(static_cast<int>(profile)) +
+    (onDemand ? "_on_demand" : "");
+}
 
+OwningBinary<ObjectFile>
+ObjectCache::getObjectFromDisk(const std::string &identifier) {
   std::string cacheName(cacheDirectory + "/" + identifier + ".o");
 
   ErrorOr<std::unique_ptr<MemoryBuffer>> buffer =
     MemoryBuffer::getFile(cacheName.c_str());
 
   if (!buffer) {
-    return nullptr;
+    return OwningBinary<ObjectFile>();
   }
 
   Expected<std::unique_ptr<ObjectFile>> objectOrError =
     ObjectFile::createObjectFile(buffer.get()->getMemBufferRef());
 
   if (!objectOrError) {
-    return nullptr;
+    consumeError(objectOrError.takeError());
+    return OwningBinary<ObjectFile>();
   }
 
   std::unique_ptr<ObjectFile> objectFile(std::move(objectOrError.get()));
 
-  auto owningObject = OwningBinary<ObjectFile>(std::move(objectFile),
-                                               std::move(buffer.get()));
+  return OwningBinary<ObjectFile>(std::move(objectFile),
+                                  std::move(buffer.get()));
+}
+
+ObjectFile *ObjectCache::getObject(const MullModule &module,
+                                   CodegenProfile profile,
+                                   bool onDemand) {
+  ObjectKey key = moduleKey(module, profile, onDemand);
+  auto it = moduleObjects.find(key);
+  if (it != moduleObjects.end()) {
+    return it->second.getBinary();
+  }
+
+  if (!useOnDiskCache) {
+    return nullptr;
+  }
+
+  auto owningObject =
+    getObjectFromDisk(cacheName(module.getUniqueIdentifier(), profile,
+                                onDemand));
   auto object = owningObject.getBinary();
   if (object != nullptr) {
-    inMemoryCache.insert(std::make_pair(identifier, std::move(owningObject)));
+    moduleObjects.insert(std::make_pair(key, std::move(owningObject)));
   }
-
   return object;
 }
 
-ObjectFile *ObjectCache::getObject(const std::string &identifier) {
-  ObjectFile *objectFile = getObjectFromMemory(identifier);
-  if (objectFile == nullptr) {
-    objectFile = getObjectFromDisk(identifier);
+ObjectFile *ObjectCache::getObject(const MutationPoint &mutationPoint,
+                                   CodegenProfile profile,
+                                   bool onDemand) {
+  ObjectKey key = mutantKey(mutationPoint, profile, onDemand);
+  auto it = mutantObjects.find(key);
+  if (it != mutantObjects.end()) {
+    mutantsByLastUse.splice(mutantsByLastUse.begin(),
+                            mutantsByLastUse,
+                            it->second.lastUse);
+    return it->second.object.getBinary();
+  }
+
+  if (!useOnDiskCache) {
+    return nullptr;
   }
-  return objectFile;
-}
 
-ObjectFile *ObjectCache::getObject(const MullModule &module) {
-  return getObject(module.getUniqueIdentifier());
+  auto owningObject =
+    getObjectFromDisk(cacheName(mutationPoint.getUniqueIdentifier(), profile,
+                                onDemand));
+  if (owningObject.getBinary() == nullptr) {
+    return nullptr;
+  }
+  return putMutantInMemory(key, std::move(owningObject));
 }
 
-ObjectFile *ObjectCache::getObject(const MutationPoint &mutationPoint) {
-  return getObject(mutationPoint.getUniqueIdentifier());
+ObjectFile *ObjectCache::putMutantInMemory(const ObjectKey &key,
+                                           OwningBinary<ObjectFile> object) {
+  auto inserted = mutantObjects.insert(std::make_pair(key, MutantObject()));
+  if (!inserted.second) {
+    return inserted.first->second.object.getBinary();
+  }
+
+  mutantsByLastUse.push_front(key);
+  mutantObjectsSize += object.getBinary()->getData().size();
+
+  MutantObject &mutant = inserted.first->second;
+  mutant.object = std::move(object);
+  mutant.lastUse = mutantsByLastUse.begin();
+  ObjectFile *objectFile = mutant.object.getBinary();
+
+  evictMutants();
+
+  return objectFile;
 }
 
-void ObjectCache::putObjectInMemory(
-                    llvm::object::OwningBinary<llvm::object::ObjectFile> object,
-                    const std::string &identifier) {
-  inMemoryCache.insert(std::make_pair(identifier, std::move(object)));
+void ObjectCache::evictMutants() {
+  if (mutantObjectsBudget == 0) {
+    return;
+  }
+
+  /// The most recent mutant stays even if it alone exceeds the budget:
+  /// it is about to be linked
+  while (mutantObjectsSize > mutantObjectsBudget &&
+         mutantsByLastUse.size() > 1) {
+    auto it = mutantObjects.find(mutantsByLastUse.back());
+    mutantsByLastUse.pop_back();
+
+    mutantObjectsSize -= it->second.object.getBinary()->getData().size();
+    mutantObjects.erase(it);
+  }
 }
 
 void ObjectCache::putObjectOnDisk(
@@ -127,17 +235,49 @@ void ObjectCache::putObjectOnDisk(
 }
 
 void ObjectCache::putObject(OwningBinary<ObjectFile> object,
-                            const std::string &identifier) {
-  putObjectOnDisk(object, identifier);
-  putObjectInMemory(std::move(object), identifier);
+                            const MullModule &module,
+                            CodegenProfile profile,
+                            bool onDemand) {
+  if (useOnDiskCache) {
+    putObjectOnDisk(object,
+                    cacheName(module.getUniqueIdentifier(), profile, onDemand));
+  }
+  moduleObjects.insert(std::make_pair(moduleKey(module, profile, onDemand),
+                                      std::move(object)));
 }
 
+/// With the on-disk cache enabled every mutant is written out here,
+/// an evicted mutant is then read back from the disk instead of being
+/// compiled again
 void ObjectCache::putObject(OwningBinary<ObjectFile> object,
-                            const MullModule &module) {
-  putObject(std::move(object), module.getUniqueIdentifier());
+                            const MutationPoint &mutationPoint,
+                            CodegenProfile profile,
+                            bool onDemand) {
+  if (useOnDiskCache) {
+    putObjectOnDisk(object, cacheName(mutationPoint.getUniqueIdentifier(),
+                                      profile,
+                                      onDemand));
+  }
+  putMutantInMemory(mutantKey(mutationPoint, profile, onDemand),
+                    std::move(object));
 }
 
-void ObjectCache::putObject(OwningBinary<ObjectFile> object,
-                            const MutationPoint &mutationPoint) {
-  putObject(std::move(object), mutationPoint.getUniqueIdentifier());
+ObjectFile *
+ObjectCache::getDispatchObject(const std::vector<MutationPoint *> &mutationPoints,
+                               CodegenProfile profile) {
+  auto it = mutantObjects.find(dispatchKey(mutationPoints, profile));
+  if (it == mutantObjects.end()) {
+    return nullptr;
+  }
+
+  mutantsByLastUse.splice(mutantsByLastUse.begin(),
+                          mutantsByLastUse,
+                          it->second.lastUse);
+  return it->second.object.getBinary();
+}
+
+void ObjectCache::putDispatchObject(OwningBinary<ObjectFile> object,
+                                    const std::vector<MutationPoint *> &mutationPoints,
+                                    CodegenProfile profile) {
+  putMutantInMemory(dispatchKey(mutationPoints, profile), std::move(object));
 }
@@ -21,7 +21,8 @@ Toolchain::Toolchain(Config &config) :
   nativeTarget(),
   machine(llvm::EngineBuilder().selectTarget(llvm::Triple(), "", "",
                                          llvm::SmallVector<std::string, 1>())),
-  objectCache(config.getUseCache(), config.getCacheDirectory()),
+  objectCache(config.getUseCache(), config.getCacheDirectory(),
+              uint64_t(config.getMutantCacheSize()) * 1024 * 1024),
   simpleCompiler(*machine.get())
 {
 }
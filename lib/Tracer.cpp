@@ -0,0 +1,204 @@
+#include "Tracer.h"
+
+#include "Logger.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace mull;
+using namespace llvm;
+using namespace std::chrono;
+
+namespace {
+
+struct TraceEvent {
+  const char *name;
+  const char *category;
+  uint64_t start;
+  uint64_t duration;
+  uint32_t track;
+};
+
+/// Events of a forked child, which cannot touch the parent's memory
+struct ChildEvents {
+  static const int Capacity = 64;
+  std::atomic<int> count;
+  TraceEvent events[Capacity];
+};
+
+const uint32_t MainTrack = 0;
+const uint32_t SandboxTrack = 1000;
+
+bool enabled = false;
+pid_t ownerPID = 0;
+std::thread::id ownerThread;
+steady_clock::time_point origin;
+
+std::mutex eventsMutex;
+std::vector<TraceEvent> events;
+std::map<std::thread::id, uint32_t> tracks;
+ChildEvents *childEvents = nullptr;
+
+uint32_t currentTrack() {
+  std::thread::id thread = std::this_thread::get_id();
+  if (thread == ownerThread) {
+    return MainTrack;
+  }
+
+  auto track = tracks.find(thread);
+  if (track != tracks.end()) {
+    return track->second;
+  }
+
+  uint32_t newTrack = tracks.size() + 1;
+  tracks.insert(std::make_pair(thread, newTrack));
+  return newTrack;
+}
+
+}
+
+void Tracer::enable() {
+  if (enabled) {
+    return;
+  }
+
+  childEvents = (ChildEvents *)mmap(NULL,
+                                    sizeof(ChildEvents),
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_ANONYMOUS,
+                                    -1,
+                                    0);
+  childEvents->count = 0;
+
+  ownerPID = getpid();
+  ownerThread = std::this_thread::get_id();
+  origin = steady_clock::now();
+  enabled = true;
+}
+
+bool Tracer::isEnabled() {
+  return enabled;
+}
+
+uint64_t Tracer::nowMicroseconds() {
+  return duration_cast<microseconds>(steady_clock::now() - origin).count();
+}
+
+void Tracer::record(const char *name, const char *category,
+                    uint64_t startMicroseconds, uint64_t durationMicroseconds) {
+  if (getpid() != ownerPID) {
+    int index = childEvents->count++;
+    if (index < ChildEvents::Capacity) {
+      childEvents->events[index] = { name, category,
+                                     startMicroseconds, durationMicroseconds,
+                                     SandboxTrack };
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  events.push_back({ name, category,
+                     startMicroseconds, durationMicroseconds,
+                     currentTrack() });
+}
+
+void Tracer::collectChildEvents() {
+  if (!enabled) {
+    return;
+  }
+
+  int count = std::min<int>(childEvents->count.load(), +ChildEvents::Capacity);
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+  events.insert(events.end(),
+                childEvents->events, childEvents->events + count);
+  childEvents->count = 0;
+}
+
+static void writeTrackName(raw_ostream &out, uint32_t track,
+                           const std::string &name) {
+  out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track
+      << ",\"args\":{\"name\":\"" << name << "\"}},\n";
+}
+
+void Tracer::writeChromeTrace(const std::string &path) {
+  std::error_code error;
+  raw_fd_ostream out(path, error, sys::fs::F_Text);
+  if (error) {
+    Logger::error() << "Tracer> cannot write " << path << ": "
+                    << error.message() << "\n";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(eventsMutex);
+
+  out << "{\"traceEvents\":[\n";
+  writeTrackName(out, MainTrack, "main");
+  writeTrackName(out, SandboxTrack, "sandbox");
+  for (auto &track : tracks) {
+    writeTrackName(out, track.second, "worker " + std::to_string(track.second));
+  }
+
+  for (size_t index = 0; index < events.size(); index++) {
+    TraceEvent &event = events[index];
+    out << "{\"name\":\"" << event.name << "\""
+        << ",\"cat\":\"" << event.category << "\""
+        << ",\"ph\":\"X\",\"pid\":1"
+        << ",\"tid\":" << event.track
+        << ",\"ts\":" << event.start
+        << ",\"dur\":" << event.duration << "}";
+    out << (index + 1 == events.size() ? "\n" : ",\n");
+  }
+  out << "]}\n";
+
+  outs() << "Trace can be found at '" << path << "'\n";
+}
+
+void Tracer::printSummary() {
+  struct Phase {
+    std::string name;
+    uint64_t count;
+    uint64_t total;
+  };
+
+  std::map<std::string, Phase> phasesByName;
+  {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    for (TraceEvent &event : events) {
+      Phase &phase = phasesByName[event.name];
+      phase.name = event.name;
+      phase.count++;
+      phase.total += event.duration;
+    }
+  }
+
+  std::vector<Phase> phases;
+  for (auto &phase : phasesByName) {
+    phases.push_back(phase.second);
+  }
+  std::sort(phases.begin(), phases.end(),
+            [](const Phase &lhs, const Phase &rhs) {
+              return lhs.total > rhs.total;
+            });
+
+  outs() << "Time per phase:\n";
+  outs() << "  phase                             count    total, ms  average, ms\n";
+  for (Phase &phase : phases) {
+    outs() << format("  %-28s %10llu %12.1f %12.3f\n",
+                     phase.name.c_str(),
+                     (unsigned long long)phase.count,
+                     phase.total / 1000.0,
+                     phase.total / 1000.0 / phase.count);
+  }
+}
@@ -0,0 +1,139 @@
+#include "TrivialCompilerEquivalence.h"
+
+#include "Logger.h"
+#include "MullModule.h"
+#include "MutationPoint.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Scalar.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+using namespace mull;
+using namespace llvm;
+
+static Function *functionAtIndex(Module *module, int index) {
+  return &*(std::next(module->begin(), index));
+}
+
+/// Gives the function the body of its pristine copy back
+static void restoreBody(Function *function, Function *pristine) {
+  GlobalValue::LinkageTypes linkage = function->getLinkage();
+  function->deleteBody();
+
+  ValueToValueMapTy map;
+  auto argument = function->arg_begin();
+  for (Argument &pristineArgument : pristine->args()) {
+    map[&pristineArgument] = &*argument++;
+  }
+
+  SmallVector<ReturnInst *, 8> returns;
+  CloneFunctionInto(function, pristine, map, false, returns);
+  function->setLinkage(linkage);
+}
+
+std::string
+TrivialCompilerEquivalence::hashOptimizedFunction(llvm::Function &function) {
+  /// The bitcode is normally built with -O0, which marks every function as
+  /// optnone. The attribute must go, otherwise no pass touches the function.
+  function.removeFnAttr(Attribute::OptimizeNone);
+  function.removeFnAttr(Attribute::NoInline);
+
+  legacy::FunctionPassManager passManager(function.getParent());
+  passManager.add(createPromoteMemoryToRegisterPass());
+  passManager.add(createSROAPass());
+  passManager.add(createEarlyCSEPass());
+  passManager.add(createInstructionCombiningPass());
+  passManager.add(createCFGSimplificationPass());
+  passManager.add(createGVNPass());
+  passManager.add(createInstructionCombiningPass());
+  passManager.add(createAggressiveDCEPass());
+  passManager.add(createCFGSimplificationPass());
+
+  passManager.doInitialization();
+  passManager.run(function);
+  passManager.doFinalization();
+
+  std::string body;
+  raw_string_ostream stream(body);
+  function.print(stream);
+  stream.flush();
+
+  MD5 hasher;
+  hasher.update(body);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str();
+}
+
+void TrivialCompilerEquivalence::analyzeFunction(
+                          const std::vector<MutationPoint *> &mutationPoints) {
+  if (mutationPoints.empty()) {
+    return;
+  }
+
+  MutationPoint *firstPoint = mutationPoints.front();
+  MullModule *originalModule = firstPoint->getOriginalModule();
+  const int functionIndex = firstPoint->getAddress().getFnIndex();
+
+  /// The module is read once for all the mutants of the function. Each of
+  /// them is applied to the original body, restored from a pristine copy.
+  /// The copy goes to the end of the module, the function indices stay.
+  LLVMContext localContext;
+  auto clonedModule = originalModule->clone(localContext);
+  if (!clonedModule) {
+    return;
+  }
+  StripDebugInfo(*clonedModule->getModule());
+  Function *function = functionAtIndex(clonedModule->getModule(),
+                                       functionIndex);
+  ValueToValueMapTy pristineMap;
+  Function *pristine = CloneFunction(function, pristineMap);
+
+  std::string originalHash = hashOptimizedFunction(*function);
+
+  std::map<std::string, MutationPoint *> uniqueMutants;
+
+  for (MutationPoint *mutationPoint : mutationPoints) {
+    assert(mutationPoint->getOriginalModule() == originalModule &&
+           mutationPoint->getAddress().getFnIndex() == functionIndex &&
+           "All mutation points must belong to the same function");
+
+    restoreBody(function, pristine);
+    mutationPoint->applyMutation(*clonedModule.get());
+    std::string mutantHash = hashOptimizedFunction(*function);
+
+    if (mutantHash == originalHash) {
+      equivalentMutants.insert(mutationPoint);
+      continue;
+    }
+
+    auto existing = uniqueMutants.find(mutantHash);
+    if (existing != uniqueMutants.end()) {
+      aliases.insert(std::make_pair(mutationPoint, existing->second));
+      continue;
+    }
+
+    uniqueMutants.insert(std::make_pair(mutantHash, mutationPoint));
+  }
+}
+
+bool TrivialCompilerEquivalence::isEquivalent(MutationPoint *mutationPoint) const {
+  return equivalentMutants.count(mutationPoint) != 0;
+}
+
+MutationPoint *
+TrivialCompilerEquivalence::aliasOf(MutationPoint *mutationPoint) const {
+  auto it = aliases.find(mutationPoint);
+  if (it == aliases.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
@@ -0,0 +1,100 @@
+#include "SyntheticModule.h"
+
+#include "MullModule.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+/// int testee_N(int x) {
+///   x = x + 1; x = x + 2; ... /// `mutationPoints` additions
+///   return x;
+/// }
+static Function *createTestee(Module &module, int index, int mutationPoints) {
+  LLVMContext &context = module.getContext();
+  Type *intType = Type::getInt32Ty(context);
+  FunctionType *type = FunctionType::get(intType, { intType }, false);
+
+  Function *function = Function::Create(type,
+                                        Function::ExternalLinkage,
+                                        "testee_" + std::to_string(index),
+                                        &module);
+
+  IRBuilder<> builder(BasicBlock::Create(context, "entry", function));
+  Value *value = &*function->arg_begin();
+  for (int point = 0; point < mutationPoints; point++) {
+    value = builder.CreateAdd(value, ConstantInt::get(intType, point + 1));
+  }
+  builder.CreateRet(value);
+
+  return function;
+}
+
+/// int test_N() {
+///   int result = 0;
+///   result ^= testee_A(N); result ^= testee_B(N); ...
+///   return result == result; /// always 1, i.e. passed
+/// }
+static void createTest(Module &module, int index,
+                       const std::vector<Function *> &testees) {
+  LLVMContext &context = module.getContext();
+  Type *intType = Type::getInt32Ty(context);
+  FunctionType *type = FunctionType::get(intType, false);
+
+  Function *function = Function::Create(type,
+                                        Function::ExternalLinkage,
+                                        "test_" + std::to_string(index),
+                                        &module);
+
+  IRBuilder<> builder(BasicBlock::Create(context, "entry", function));
+  Value *result = ConstantInt::get(intType, 0);
+  for (Function *testee : testees) {
+    Value *call = builder.CreateCall(testee,
+                                     { ConstantInt::get(intType, index) });
+    result = builder.CreateXor(result, call);
+  }
+  Value *passed = builder.CreateICmpEQ(result, result);
+  builder.CreateRet(builder.CreateZExt(passed, intType));
+}
+
+std::unique_ptr<MullModule>
+mull::createSyntheticModule(LLVMContext &context,
+                            const SyntheticModuleShape &shape) {
+  auto module = make_unique<Module>("synthetic", context);
+
+  std::vector<std::vector<Function *>> testeesOfTests(std::max(1, shape.tests));
+  for (int index = 0; index < shape.functions; index++) {
+    Function *testee = createTestee(*module, index,
+                                    shape.mutationPointsPerFunction);
+    testeesOfTests[index % testeesOfTests.size()].push_back(testee);
+  }
+
+  for (int index = 0; index < shape.tests; index++) {
+    createTest(*module, index, testeesOfTests[index]);
+  }
+
+  /// The same shape always produces the same module
+  std::string shapeName = "synthetic_" + std::to_string(shape.functions) +
+    "_" + std::to_string(shape.mutationPointsPerFunction) +
+    "_" + std::to_string(shape.tests);
+  MD5 hasher;
+  hasher.update(shapeName);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> hashString;
+  MD5::stringifyResult(hash, hashString);
+
+  return make_unique<MullModule>(std::move(module),
+                                 hashString.str(),
+                                 shapeName + ".bc");
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+
+namespace llvm {
+class LLVMContext;
+}
+
+namespace mull {
+
+class MullModule;
+
+/// Shape of a generated module
+struct SyntheticModuleShape {
+  /// Number of testee functions
+  int functions;
+  /// Number of `add` instructions (and therefore of math_add mutation points)
+  /// in each testee
+  int mutationPointsPerFunction;
+  /// Number of `test_` functions, testee N is called by test N % tests
+  int tests;
+};
+
+/// Generates a module of the given shape which is runnable with the
+/// SimpleTest framework: every test passes on the original code.
+std::unique_ptr<MullModule>
+createSyntheticModule(llvm::LLVMContext &context,
+                      const SyntheticModuleShape &shape);
+
+}
@@ -0,0 +1,394 @@
+#include "Config.h"
+#include "Context.h"
+#include "DynamicCallTree.h"
+#include "Filter.h"
+#include "ForkProcessSandbox.h"
+#include "Logger.h"
+#include "MullModule.h"
+#include "MutationOperators/MathAddMutationOperator.h"
+#include "MutationsFinder.h"
+#include "Result.h"
+#include "SQLiteReporter.h"
+#include "SimpleTest/SimpleTestFinder.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "Testee.h"
+#include "TestResult.h"
+#include "Toolchain/Toolchain.h"
+
+#include "SyntheticModule.h"
+
+#include <llvm/Bitcode/ReaderWriter.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <stack>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace mull;
+using namespace llvm;
+using namespace std::chrono;
+
+cl::OptionCategory MullBenchOptionCategory("Mull Bench");
+
+static cl::opt<int> Functions(
+    "functions",
+    cl::desc("Number of testee functions in the synthetic module"),
+    cl::init(200),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::opt<int> MutationPoints(
+    "mutation-points",
+    cl::desc("Number of mutation points in each testee function"),
+    cl::init(20),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::opt<int> Tests(
+    "tests",
+    cl::desc("Number of tests in the synthetic module"),
+    cl::init(20),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::opt<int> Iterations(
+    "iterations",
+    cl::desc("How many times each benchmark is repeated"),
+    cl::init(5),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::opt<int> Workers(
+    "workers",
+    cl::desc("Number of threads used to search for mutation points"),
+    cl::init(1),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::list<std::string> Benchmarks(
+    "benchmark",
+    cl::desc("Benchmark to run, all of them if none is given"),
+    cl::value_desc("MutationsFinder|DynamicCallTree|Compiler|"
+                   "ForkProcessSandbox|SQLiteReporter"),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::opt<std::string> OutputFile(
+    "o",
+    cl::desc("Where to write the results, one JSON object per line"),
+    cl::value_desc("results.jsonl"),
+    cl::init("-"),
+    cl::cat(MullBenchOptionCategory)
+);
+
+static cl::opt<std::string> GenerateBitcode(
+    "generate",
+    cl::desc("Only write the synthetic module, e.g. to run mull-driver on it"),
+    cl::value_desc("synthetic.bc"),
+    cl::cat(MullBenchOptionCategory)
+);
+
+namespace {
+
+/// Everything the benchmarks work on: the synthetic module, its tests
+/// and its mutation points
+struct Fixture {
+  LLVMContext llvmContext;
+  Context context;
+  Filter filter;
+  std::vector<std::unique_ptr<Test>> tests;
+  std::vector<Function *> testFunctions;
+  std::vector<Function *> testees;
+  std::vector<MutationPoint *> mutationPoints;
+  std::unique_ptr<MutationsFinder> finder;
+
+  Fixture(const SyntheticModuleShape &shape) {
+    context.addModule(createSyntheticModule(llvmContext, shape));
+
+    SimpleTestFinder testFinder;
+    tests = testFinder.findTests(context, filter);
+
+    for (auto &module : context.getModules()) {
+      for (Function &function : module->getModule()->getFunctionList()) {
+        if (function.getName().startswith("testee_")) {
+          testees.push_back(&function);
+        } else if (function.getName().startswith("test_")) {
+          testFunctions.push_back(&function);
+        }
+      }
+    }
+
+    finder = createFinder();
+    finder->findMutationPoints(context, testees, filter, 1);
+    for (Function *function : testees) {
+      Testee testee(function, 1);
+      auto points = finder->getMutationPoints(context, testee, filter);
+      mutationPoints.insert(mutationPoints.end(), points.begin(), points.end());
+    }
+  }
+
+  static std::unique_ptr<MutationsFinder> createFinder() {
+    std::vector<std::unique_ptr<MutationOperator>> operators;
+    operators.emplace_back(make_unique<MathAddMutationOperator>());
+    return make_unique<MutationsFinder>(std::move(operators));
+  }
+
+  MullModule &module() {
+    return *context.getModules().front();
+  }
+};
+
+class BenchmarkRunner {
+  raw_ostream &out;
+  const SyntheticModuleShape &shape;
+
+public:
+  BenchmarkRunner(raw_ostream &out, const SyntheticModuleShape &shape)
+    : out(out), shape(shape) {}
+
+  static bool isSelected(const std::string &name) {
+    return Benchmarks.empty() ||
+      std::find(Benchmarks.begin(), Benchmarks.end(), name) != Benchmarks.end();
+  }
+
+  /// Runs `setUp` and then times `body`, `Iterations` times.
+  /// `items` is the amount of work done by a single run of `body`.
+  void run(const std::string &name, uint64_t items,
+           std::function<void ()> setUp,
+           std::function<void ()> body) {
+    if (!isSelected(name)) {
+      return;
+    }
+
+    std::vector<uint64_t> durations;
+    for (int iteration = 0; iteration < Iterations; iteration++) {
+      setUp();
+      auto start = steady_clock::now();
+      body();
+      auto elapsed = steady_clock::now() - start;
+      durations.push_back(duration_cast<microseconds>(elapsed).count());
+    }
+
+    std::sort(durations.begin(), durations.end());
+    uint64_t total = 0;
+    for (uint64_t duration : durations) {
+      total += duration;
+    }
+    uint64_t median = durations[durations.size() / 2];
+    uint64_t mean = total / durations.size();
+
+    out << "{\"benchmark\":\"" << name << "\""
+        << ",\"functions\":" << shape.functions
+        << ",\"mutation_points\":" << shape.mutationPointsPerFunction
+        << ",\"tests\":" << shape.tests
+        << ",\"iterations\":" << durations.size()
+        << ",\"items\":" << items
+        << ",\"min_us\":" << durations.front()
+        << ",\"median_us\":" << median
+        << ",\"mean_us\":" << mean
+        << ",\"max_us\":" << durations.back()
+        << "}\n";
+    out.flush();
+
+    errs() << name << ": median " << median << " us, "
+           << items << " items\n";
+  }
+};
+
+}
+
+static void benchmarkMutationsFinder(BenchmarkRunner &runner, Fixture &fixture) {
+  std::unique_ptr<MutationsFinder> finder;
+  runner.run("MutationsFinder", fixture.testees.size(),
+    [&]() {
+      finder = Fixture::createFinder();
+    },
+    [&]() {
+      finder->findMutationPoints(fixture.context, fixture.testees,
+                                 fixture.filter, Workers);
+    });
+}
+
+static void benchmarkDynamicCallTree(BenchmarkRunner &runner, Fixture &fixture) {
+  /// The layout Driver uses: the phony function first, then every function
+  std::vector<CallTreeFunction> functions;
+  functions.push_back(CallTreeFunction(nullptr));
+  for (Function &function : fixture.module().getModule()->getFunctionList()) {
+    functions.push_back(CallTreeFunction(&function));
+  }
+
+  std::vector<uint64_t> mapping(functions.size(), 0);
+  DynamicCallTree dynamicCallTree(functions);
+  dynamicCallTree.prepare(mapping.data());
+
+  std::map<Function *, uint64_t> indices;
+  for (uint64_t index = 1; index < functions.size(); index++) {
+    indices[functions[index].function] = index;
+  }
+
+  runner.run("DynamicCallTree", functions.size() - 1,
+    [&]() {
+      /// Replaying what the injected callbacks record when every test
+      /// calls its testees once
+      std::stack<uint64_t> stack;
+      for (Function *test : fixture.testFunctions) {
+        uint64_t testIndex = indices[test];
+        DynamicCallTree::enterFunction(testIndex, mapping.data(), stack);
+        for (Instruction &instruction : test->getEntryBlock()) {
+          if (auto call = dyn_cast<CallInst>(&instruction)) {
+            uint64_t calleeIndex = indices[call->getCalledFunction()];
+            DynamicCallTree::enterFunction(calleeIndex, mapping.data(), stack);
+            DynamicCallTree::leaveFunction(calleeIndex, mapping.data(), stack);
+          }
+        }
+        DynamicCallTree::leaveFunction(testIndex, mapping.data(), stack);
+      }
+    },
+    [&]() {
+      dynamicCallTree.cleanupCallTree(dynamicCallTree.createCallTree());
+    });
+}
+
+static void benchmarkCompiler(BenchmarkRunner &runner, Fixture &fixture,
+                              Toolchain &toolchain) {
+  runner.run("Compiler", fixture.testees.size() + fixture.tests.size(),
+    []() {},
+    [&]() {
+      toolchain.compiler().compileModule(fixture.module());
+    });
+}
+
+static void benchmarkForkProcessSandbox(BenchmarkRunner &runner) {
+  const int runs = 100;
+  ForkProcessSandbox sandbox;
+  runner.run("ForkProcessSandbox", runs,
+    []() {},
+    [&]() {
+      for (int run = 0; run < runs; run++) {
+        sandbox.run([]() {
+          return ExecutionStatus::Passed;
+        }, 1000);
+      }
+    });
+}
+
+static void benchmarkSQLiteReporter(BenchmarkRunner &runner, Fixture &fixture) {
+  ExecutionResult passed;
+  passed.status = Passed;
+  passed.runningTime = 1;
+  passed.stdoutOutput = "[ RUN      ] test\n[       OK ] test\n";
+
+  ExecutionResult failed;
+  failed.status = Failed;
+  failed.runningTime = 2;
+  failed.stdoutOutput = "[ RUN      ] test\n[  FAILED  ] test\n";
+
+  Config config;
+  std::string databasePath;
+  int iteration = 0;
+
+  runner.run("SQLiteReporter", fixture.mutationPoints.size(),
+    [&]() {
+      if (!databasePath.empty()) {
+        sys::fs::remove(databasePath);
+        sys::fs::remove(databasePath + "-wal");
+        sys::fs::remove(databasePath + "-shm");
+      }
+    },
+    [&]() {
+      SQLiteReporter reporter("mull-bench_" + std::to_string(getpid()) +
+                              "_" + std::to_string(iteration++));
+      databasePath = reporter.getDatabasePath();
+      reporter.begin(config, { fixture.module().getUniqueIdentifier() });
+
+      /// Each mutant is reported once, against one of the tests
+      for (size_t index = 0; index < fixture.mutationPoints.size(); index++) {
+        Test *test = fixture.tests[index % fixture.tests.size()].get();
+        TestResult testResult(passed, make_unique<SimpleTest_Test>(
+          cast<SimpleTest_Test>(test)->GetTestFunction()));
+        if (index < fixture.tests.size()) {
+          reporter.reportTest(testResult);
+        }
+
+        MutationResult mutationResult(index % 2 ? passed : failed,
+                                      fixture.mutationPoints[index], 1);
+        reporter.reportMutant(testResult, mutationResult);
+      }
+
+      reporter.finish(config, ResultTime(0, 0));
+    });
+
+  sys::fs::remove(databasePath);
+  sys::fs::remove(databasePath + "-wal");
+  sys::fs::remove(databasePath + "-shm");
+}
+
+int main(int argc, char *argv[]) {
+  cl::HideUnrelatedOptions(MullBenchOptionCategory);
+  cl::ParseCommandLineOptions(argc, argv,
+                              "Micro-benchmarks of the mutation pipeline "
+                              "on a synthetic module");
+
+  SyntheticModuleShape shape;
+  shape.functions = Functions;
+  shape.mutationPointsPerFunction = MutationPoints;
+  shape.tests = Tests;
+
+  if (shape.functions < 1 || shape.mutationPointsPerFunction < 1 ||
+      shape.tests < 1 || Iterations < 1) {
+    Logger::error() << "mull-bench: -functions, -mutation-points, -tests "
+                    << "and -iterations must be positive\n";
+    return EXIT_FAILURE;
+  }
+
+  if (!GenerateBitcode.empty()) {
+    LLVMContext context;
+    auto module = createSyntheticModule(context, shape);
+
+    std::error_code error;
+    raw_fd_ostream out(GenerateBitcode, error, sys::fs::F_None);
+    if (error) {
+      Logger::error() << "mull-bench: cannot write " << GenerateBitcode
+                      << ": " << error.message() << "\n";
+      return EXIT_FAILURE;
+    }
+    WriteBitcodeToFile(module->getModule(), out);
+
+    llvm_shutdown();
+    return EXIT_SUCCESS;
+  }
+
+  std::error_code error;
+  raw_fd_ostream out(OutputFile, error, sys::fs::F_Text);
+  if (error) {
+    Logger::error() << "mull-bench: cannot write " << OutputFile
+                    << ": " << error.message() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  Config config;
+  Toolchain toolchain(config);
+
+  Fixture fixture(shape);
+  BenchmarkRunner runner(out, shape);
+
+  benchmarkMutationsFinder(runner, fixture);
+  benchmarkDynamicCallTree(runner, fixture);
+  benchmarkCompiler(runner, fixture, toolchain);
+  benchmarkForkProcessSandbox(runner);
+  benchmarkSQLiteReporter(runner, fixture);
+
+  llvm_shutdown();
+  return EXIT_SUCCESS;
+}
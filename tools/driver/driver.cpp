@@ -11,6 +11,7 @@
 #include "MutationsFinder.h"
 
 #include "Toolchain/Toolchain.h"
+#include "Tracer.h"
 
 #include "GoogleTest/GoogleTestFinder.h"
 #include "GoogleTest/GoogleTestRunner.h"
@@ -69,6 +70,10 @@ int main(int argc, char *argv[]) {
     exit(1);
   }
 
+  if (!config.getTraceFilePath().empty()) {
+    Tracer::enable();
+  }
+
   config.dump();
 
   InitializeNativeTarget();
@@ -76,7 +81,8 @@ int main(int argc, char *argv[]) {
   InitializeNativeTargetAsmParser();
 
   LLVMContext Ctx;
-  ModuleLoader Loader(Ctx);
+  ModuleLoader Loader(Ctx, config.getWorkers(),
+                      config.shouldLoadBitcodeLazily());
   Toolchain toolchain(config);
   Filter filter;
 
@@ -108,7 +114,7 @@ int main(int argc, char *argv[]) {
     filter.skipByLocation("gtest");
     filter.skipByLocation("gmock");
 
-    testFinder = make_unique<GoogleTestFinder>();
+    testFinder = make_unique<GoogleTestFinder>(config.getWorkers());
     testRunner = make_unique<GoogleTestRunner>(toolchain.targetMachine());
   }
 
@@ -142,6 +148,14 @@ int main(int argc, char *argv[]) {
 
   Driver driver(config, Loader, *testFinder, *testRunner, toolchain, filter, mutationsFinder);
 
+  SQLiteReporter reporter(config.getProjectName());
+  reporter.setEmitDebugInfo(config.shouldEmitDebugInfo());
+  reporter.setKeepOutputOnlyForKilledMutants(config.getKeepOutput() == "killed");
+  if (!config.getResumeDatabasePath().empty()) {
+    reporter.resumeFrom(config.getResumeDatabasePath());
+  }
+  driver.setResultSink(&reporter);
+
   const long timeSuiteStart =
     duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
 
@@ -152,8 +166,12 @@ int main(int argc, char *argv[]) {
 
   ResultTime resultTime(timeSuiteStart, timeSuiteEnd);
 
-  SQLiteReporter reporter(config.getProjectName());
-  reporter.reportResults(result, config, resultTime);
+  reporter.finish(config, resultTime);
+
+  if (Tracer::isEnabled()) {
+    Tracer::writeChromeTrace(config.getTraceFilePath());
+    Tracer::printSummary();
+  }
 
   llvm_shutdown();
   return EXIT_SUCCESS;
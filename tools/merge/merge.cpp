@@ -0,0 +1,40 @@
+#include "Logger.h"
+#include "SQLiteReporter.h"
+
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/ManagedStatic.h>
+
+#include <string>
+#include <vector>
+
+using namespace mull;
+using namespace llvm;
+
+cl::OptionCategory MullMergeOptionCategory("Mull Merge");
+
+static cl::opt<std::string> OutputFile(
+    "o",
+    cl::desc("Path of the merged results database"),
+    cl::value_desc("output.sqlite"),
+    cl::Required,
+    cl::cat(MullMergeOptionCategory)
+);
+
+static cl::list<std::string> InputFiles(
+    cl::desc("<shard results databases>"),
+    cl::Positional,
+    cl::OneOrMore,
+    cl::cat(MullMergeOptionCategory)
+);
+
+int main(int argc, char *argv[]) {
+  cl::HideUnrelatedOptions(MullMergeOptionCategory);
+  cl::ParseCommandLineOptions(argc, argv,
+                              "Combines the results of the shards of a run");
+
+  std::vector<std::string> inputs(InputFiles.begin(), InputFiles.end());
+  SQLiteReporter::mergeDatabases(OutputFile, inputs);
+
+  llvm_shutdown();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+#include "BaselineBatch.h"
+#include "DynamicCallTree.h"
+
+#include "gtest/gtest.h"
+
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+
+using namespace mull;
+using namespace llvm;
+
+static LLVMContext context;
+
+static Function *batchFunction(const char *name) {
+  FunctionType *type = FunctionType::get(Type::getVoidTy(context), false);
+  return Function::Create(type, Function::ExternalLinkage, name, nullptr);
+}
+
+TEST(BaselineBatch, recordsSeparateCallTreePerTest) {
+  Function *runner = batchFunction("runner");
+  Function *test1 = batchFunction("test1");
+  Function *test2 = batchFunction("test2");
+  Function *shared = batchFunction("shared");
+  Function *other = batchFunction("other");
+
+  std::vector<CallTreeFunction> functions;
+  functions.push_back(CallTreeFunction(nullptr));
+  functions.push_back(CallTreeFunction(runner));
+  functions.push_back(CallTreeFunction(test1));
+  functions.push_back(CallTreeFunction(test2));
+  functions.push_back(CallTreeFunction(shared));
+  functions.push_back(CallTreeFunction(other));
+
+  BaselineBatch batch(functions.size(), 2);
+  batch.begin({ { 2 }, { 3 } });
+
+  ///   runner -> test1 -> shared
+  ///   runner -> test2 -> shared -> other
+  ///   runner -> other
+  std::stack<uint64_t> stack;
+  batch.enterFunction(1, stack);
+  batch.enterFunction(2, stack);
+  batch.enterFunction(4, stack);
+  batch.leaveFunction(4, stack);
+  batch.leaveFunction(2, stack);
+  batch.enterFunction(3, stack);
+  batch.enterFunction(4, stack);
+  batch.enterFunction(5, stack);
+  batch.leaveFunction(5, stack);
+  batch.leaveFunction(4, stack);
+  batch.leaveFunction(3, stack);
+  batch.enterFunction(5, stack);
+  batch.leaveFunction(5, stack);
+  batch.leaveFunction(1, stack);
+  batch.end();
+
+  ASSERT_TRUE(stack.empty());
+  ASSERT_TRUE(batch.hasFinished(0));
+  ASSERT_TRUE(batch.hasFinished(1));
+
+  DynamicCallTree tree(functions);
+
+  /// Calls made by the runner itself are not part of any test
+  std::unique_ptr<CallTree> firstTree = tree.createCallTree(batch.mapping(0));
+  ASSERT_EQ(1U, firstTree->children.size());
+  CallTree *test1Node = firstTree->children.front().get();
+  ASSERT_EQ(test1, test1Node->function);
+  ASSERT_EQ(1U, test1Node->children.size());
+  ASSERT_EQ(shared, test1Node->children.front()->function);
+  ASSERT_TRUE(test1Node->children.front()->children.empty());
+  tree.cleanupCallTree(std::move(firstTree));
+
+  /// `shared` was called by the first test too, it is recorded nevertheless
+  std::unique_ptr<CallTree> secondTree = tree.createCallTree(batch.mapping(1));
+  ASSERT_EQ(1U, secondTree->children.size());
+  CallTree *test2Node = secondTree->children.front().get();
+  ASSERT_EQ(test2, test2Node->function);
+  ASSERT_EQ(1U, test2Node->children.size());
+  CallTree *sharedNode = test2Node->children.front().get();
+  ASSERT_EQ(shared, sharedNode->function);
+  ASSERT_EQ(1U, sharedNode->children.size());
+  ASSERT_EQ(other, sharedNode->children.front()->function);
+  tree.cleanupCallTree(std::move(secondTree));
+}
+
+TEST(BaselineBatch, testThatDidNotReturnIsNotFinished) {
+  std::vector<CallTreeFunction> functions;
+  functions.push_back(CallTreeFunction(nullptr));
+  functions.push_back(CallTreeFunction(batchFunction("test1")));
+  functions.push_back(CallTreeFunction(batchFunction("test2")));
+
+  BaselineBatch batch(functions.size(), 2);
+  batch.begin({ { 1 }, { 2 } });
+
+  std::stack<uint64_t> stack;
+  batch.enterFunction(1, stack);
+  batch.end();
+
+  ASSERT_FALSE(batch.hasFinished(0));
+  ASSERT_FALSE(batch.hasFinished(1));
+}
@@ -31,3 +31,69 @@ TEST(Compiler, CompileModule) {
 
   ASSERT_NE(nullptr, Binary.getBinary());
 }
+
+TEST(Compiler, CompileModuleWithEachProfile) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+
+  Compiler compiler(*targetMachine.get());
+
+  for (CodegenProfile profile : { CodegenProfile::Fast,
+                                  CodegenProfile::Default,
+                                  CodegenProfile::Optimized }) {
+    auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+    auto Binary = compiler.compileModule(module->getModule(), profile);
+
+    ASSERT_NE(nullptr, Binary.getBinary());
+  }
+}
+
+TEST(CodegenProfileSelector, FixedProfile) {
+  CodegenProfileSelector selector("fast");
+  selector.addCompileTime(CodegenProfile::Default, 100);
+
+  ASSERT_EQ(CodegenProfile::Fast, selector.select(1));
+  ASSERT_EQ(CodegenProfile::Fast, selector.select(10000));
+}
+
+TEST(CodegenProfileSelector, AutomaticProfile) {
+  CodegenProfileSelector selector("auto");
+
+  /// The default profile is measured first
+  ASSERT_EQ(CodegenProfile::Default, selector.select(1));
+
+  selector.addCompileTime(CodegenProfile::Default, 100);
+  selector.addCompileTime(CodegenProfile::Default, 300);
+  selector.addCompileTime(CodegenProfile::Fast, 10);
+
+  ASSERT_EQ(CodegenProfile::Fast, selector.select(100));
+  ASSERT_EQ(CodegenProfile::Default, selector.select(200));
+  ASSERT_EQ(CodegenProfile::Optimized, selector.select(2001));
+}
+
+TEST(CodegenProfileSelector, RecordsEveryProfileAndResamplesDefault) {
+  CodegenProfileSelector selector("auto");
+  selector.addCompileTime(CodegenProfile::Default, 100);
+
+  /// A long test picks the optimized profile from then on
+  ASSERT_EQ(CodegenProfile::Optimized, selector.select(5000));
+  for (int i = 0; i < 15; i++) {
+    selector.addCompileTime(CodegenProfile::Optimized, 400);
+    ASSERT_EQ(CodegenProfile::Optimized, selector.select(5000));
+  }
+  ASSERT_EQ(400, selector.averageCompileTime(CodegenProfile::Optimized));
+
+  /// Until the default profile is due for another sample
+  selector.addCompileTime(CodegenProfile::Optimized, 400);
+  ASSERT_EQ(CodegenProfile::Default, selector.select(5000));
+
+  /// Compiling got slower, the same test is no longer worth optimizing
+  selector.addCompileTime(CodegenProfile::Default, 900);
+  ASSERT_EQ(500, selector.averageCompileTime(CodegenProfile::Default));
+  ASSERT_EQ(CodegenProfile::Default, selector.select(4000));
+}
@@ -316,3 +316,19 @@ exclude_locations:
   ASSERT_EQ("include/c++/v1", excludeLocations[0]);
   ASSERT_EQ("llvm/include", excludeLocations[1]);
 }
+
+TEST_F(ConfigParserTestFixture, loadConfig_workers_negative) {
+  const std::string bitcodeFileList = "/tmp/bitcode_file_list.txt";
+  std::ofstream bitcodeFile(bitcodeFileList);
+  bitcodeFile << "foo.bc" << std::endl;
+
+  const char *configYAML = R"YAML(
+bitcode_file_list: /tmp/bitcode_file_list.txt
+workers: -1
+  )YAML";
+  configWithYamlContent(configYAML);
+
+  auto errors = config.validate();
+  ASSERT_EQ(1U, errors.size());
+  ASSERT_EQ("workers parameter must be at least 1, got: -1", errors.front());
+}
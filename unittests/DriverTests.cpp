@@ -1,4 +1,5 @@
 #include "Config.h"
+#include "ConfigParser.h"
 #include "Context.h"
 #include "Driver.h"
 #include "Filter.h"
@@ -13,6 +14,7 @@
 #include "MutationOperators/RemoveVoidFunctionMutationOperator.h"
 #include "MutationOperators/ReplaceAssignmentMutationOperator.h"
 #include "Result.h"
+#include "ResultSink.h"
 #include "SimpleTest/SimpleTestFinder.h"
 #include "SimpleTest/SimpleTestRunner.h"
 #include "TestModuleFactory.h"
@@ -24,6 +26,7 @@
 #include "Toolchain/Toolchain.h"
 
 #include <functional>
+#include <map>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/Twine.h>
 #include <llvm/IR/LLVMContext.h>
@@ -125,6 +128,173 @@ TEST(Driver, SimpleTest_MathAddMutationOperator) {
   ASSERT_NE(nullptr, FirstMutant->getMutationPoint());
 }
 
+class RecordingResultSink : public ResultSink {
+public:
+  std::vector<std::string> tests;
+  std::vector<ExecutionStatus> mutants;
+  bool finished = false;
+
+  void begin(const Config &config,
+             const std::vector<std::string> &bitcodeHashes) override {}
+
+  bool isReported(TestResult &testResult,
+                  MutationPoint &mutationPoint) override {
+    return false;
+  }
+
+  void reportTest(TestResult &testResult) override {
+    tests.push_back(testResult.getTestName());
+  }
+
+  void reportMutant(TestResult &testResult,
+                    MutationResult &mutationResult) override {
+    mutants.push_back(mutationResult.getExecutionResult().status);
+  }
+
+  void finish(const Config &config, const ResultTime &resultTime) override {
+    finished = true;
+  }
+};
+
+TEST(Driver, SimpleTest_MathAddMutationOperator_streamsResults) {
+  Config config("",
+                "some_project",
+                "SimpleTest",
+                {},
+                {},
+                {},
+                {},
+                {},
+                {},
+                false,
+                false,
+                false,
+                false,
+                false,
+                MullDefaultTimeoutMilliseconds,
+                10,
+                "/tmp/mull_cache");
+
+  std::function<std::vector<std::unique_ptr<MullModule>> ()> modules = [](){
+    std::vector<std::unique_ptr<MullModule>> modules;
+
+    modules.push_back(SharedTestModuleFactory.create_SimpleTest_CountLettersTest_Module());
+    modules.push_back(SharedTestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+    return modules;
+  };
+
+  LLVMContext context;
+  FakeModuleLoader loader(context, modules);
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  SimpleTestFinder testFinder;
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.targetMachine());
+  Filter filter;
+
+  RecordingResultSink sink;
+
+  Driver Driver(config, loader, testFinder, runner, toolchain, filter, finder);
+  Driver.setResultSink(&sink);
+
+  auto result = Driver.Run();
+
+  ASSERT_EQ(1u, sink.tests.size());
+  ASSERT_EQ("test_count_letters", sink.tests.front());
+
+  ASSERT_EQ(1u, sink.mutants.size());
+  ASSERT_EQ(ExecutionStatus::Failed, sink.mutants.front());
+
+  /// Streamed mutants are not accumulated
+  ASSERT_EQ(1u, result->getTestResults().size());
+  ASSERT_EQ(0u, result->getTestResults().front()->getMutationResults().size());
+
+  /// Finishing the report is up to the caller
+  ASSERT_FALSE(sink.finished);
+}
+
+#pragma mark - Compile on demand
+
+/// Runs the static testee fixture, returns the status of every mutant by the
+/// name of the test and the identifier of the mutant
+static std::map<std::string, ExecutionStatus>
+runStaticTesteeFixture(bool compileOnDemand) {
+  std::string configYAML = std::string("test_framework: SimpleTest\n"
+                                       "fork: false\n"
+                                       "compile_on_demand: ") +
+    (compileOnDemand ? "true" : "false") + "\n";
+  yaml::Input input(configYAML);
+  ConfigParser parser;
+  Config config = parser.loadConfig(input);
+
+  std::function<std::vector<std::unique_ptr<MullModule>> ()> modules = [](){
+    std::vector<std::unique_ptr<MullModule>> modules;
+
+    modules.push_back(SharedTestModuleFactory.create_SimpleTest_StaticTesteeTest_Module());
+    modules.push_back(SharedTestModuleFactory.create_SimpleTest_StaticTestee_Module());
+
+    return modules;
+  };
+
+  LLVMContext context;
+  FakeModuleLoader loader(context, modules);
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  SimpleTestFinder testFinder;
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.targetMachine());
+  Filter filter;
+
+  Driver driver(config, loader, testFinder, runner, toolchain, filter, finder);
+  auto result = driver.Run();
+
+  std::map<std::string, ExecutionStatus> statuses;
+  for (auto &testResult : result->getTestResults()) {
+    EXPECT_EQ(ExecutionStatus::Passed,
+              testResult->getOriginalTestResult().status);
+
+    for (auto &mutationResult : testResult->getMutationResults()) {
+      MutationPoint *mutationPoint = mutationResult->getMutationPoint();
+      std::string key = testResult->getTestName() + " " +
+        mutationPoint->getUniqueIdentifier();
+      statuses[key] = mutationResult->getExecutionResult().status;
+
+      /// Both tests reach the mutant, the second one runs the cached object
+      EXPECT_NE(nullptr, toolchain.cache().getObject(*mutationPoint,
+                                                     CodegenProfile::Default,
+                                                     compileOnDemand));
+    }
+  }
+
+  return statuses;
+}
+
+TEST(Driver, SimpleTest_compileOnDemand_matchesDefaultMode) {
+  auto defaultStatuses = runStaticTesteeFixture(false);
+  auto onDemandStatuses = runStaticTesteeFixture(true);
+
+  /// One mutant of the static add, reached by both tests
+  ASSERT_EQ(2U, defaultStatuses.size());
+  ASSERT_EQ(defaultStatuses, onDemandStatuses);
+
+  for (auto &status : onDemandStatuses) {
+    if (status.first.find("test_sum_of_three ") == 0) {
+      ASSERT_EQ(ExecutionStatus::Failed, status.second);
+    } else {
+      ASSERT_EQ(ExecutionStatus::Passed, status.second);
+    }
+  }
+}
+
 TEST(Driver, SimpleTest_MathSubMutationOperator) {
     /// Create Config with fake BitcodePaths
     /// Create Fake Module Loader
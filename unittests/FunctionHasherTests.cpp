@@ -0,0 +1,148 @@
+#include "Context.h"
+#include "FunctionHasher.h"
+#include "MullModule.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+static std::unique_ptr<Module> parseModule(LLVMContext &context,
+                                           const char *source) {
+  SMDiagnostic error;
+  auto module = parseAssemblyString(source, error, context);
+  assert(module && "Expected module to be parsed correctly");
+  return module;
+}
+
+TEST(FunctionHasher, hashFunctionBody_isStableAcrossClones) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  LLVMContext firstContext;
+  auto firstClone = module->clone(firstContext);
+  LLVMContext secondContext;
+  auto secondClone = module->clone(secondContext);
+
+  Function *first = firstClone->getModule()->getFunction("count_letters");
+  Function *second = secondClone->getModule()->getFunction("count_letters");
+
+  ASSERT_EQ(FunctionHasher::hashFunctionBody(*first),
+            FunctionHasher::hashFunctionBody(*second));
+}
+
+TEST(FunctionHasher, computeHashes_coversCallees) {
+  Context context;
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLettersTest_Module());
+  context.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+  Function *test = context.lookupDefinedFunction("test_count_letters");
+  Function *testee = context.lookupDefinedFunction("count_letters");
+
+  FunctionHasher shallowHasher;
+  shallowHasher.computeHashes(context, 0);
+
+  FunctionHasher deepHasher;
+  deepHasher.computeHashes(context, 1);
+
+  ASSERT_FALSE(deepHasher.hashOf(testee).empty());
+  ASSERT_NE(deepHasher.hashOf(test), deepHasher.hashOf(testee));
+
+  /// count_letters calls nothing, the test calls count_letters
+  ASSERT_EQ(shallowHasher.hashOf(testee), deepHasher.hashOf(testee));
+  ASSERT_NE(shallowHasher.hashOf(test), deepHasher.hashOf(test));
+}
+
+TEST(FunctionHasher, hashFunctionBody_coversGlobalsPhisAndAttributes) {
+  const char *source = R"IR(
+@limit = constant i32 7
+@other = constant i32 8
+
+define i32 @read_limit() {
+  %1 = load i32, i32* @limit
+  ret i32 %1
+}
+
+define i32 @pick(i1 %condition) {
+entry:
+  br i1 %condition, label %left, label %right
+left:
+  br label %exit
+right:
+  br label %exit
+exit:
+  %result = phi i32 [ 1, %left ], [ 2, %right ]
+  ret i32 %result
+}
+)IR";
+
+  LLVMContext context;
+  auto module = parseModule(context, source);
+  Function *readLimit = module->getFunction("read_limit");
+  Function *pick = module->getFunction("pick");
+
+  std::string limitHash = FunctionHasher::hashFunctionBody(*readLimit);
+  module->getNamedGlobal("limit")->setInitializer(
+    ConstantInt::get(Type::getInt32Ty(context), 8));
+  ASSERT_NE(limitHash, FunctionHasher::hashFunctionBody(*readLimit));
+
+  std::string pickHash = FunctionHasher::hashFunctionBody(*pick);
+  PHINode *phi = cast<PHINode>(&pick->back().front());
+  BasicBlock *left = phi->getIncomingBlock(0);
+  phi->setIncomingBlock(0, phi->getIncomingBlock(1));
+  phi->setIncomingBlock(1, left);
+  ASSERT_NE(pickHash, FunctionHasher::hashFunctionBody(*pick));
+
+  std::string attributesHash = FunctionHasher::hashFunctionBody(*readLimit);
+  readLimit->addFnAttr(Attribute::NoInline);
+  ASSERT_NE(attributesHash, FunctionHasher::hashFunctionBody(*readLimit));
+}
+
+TEST(FunctionHasher, computeHashes_coversFunctionsTakenByAddress) {
+  const char *source = R"IR(
+define i32 @callback() {
+  ret i32 1
+}
+
+define i32 @call(i32 ()* %function) {
+  %1 = call i32 %function()
+  ret i32 %1
+}
+
+define i32 @test() {
+  %1 = call i32 @call(i32 ()* @callback)
+  ret i32 %1
+}
+)IR";
+
+  auto llvmContext = make_unique<LLVMContext>();
+  auto module = parseModule(*llvmContext, source);
+  Function *callback = module->getFunction("callback");
+  Function *test = module->getFunction("test");
+
+  Context context;
+  context.addModule(make_unique<MullModule>(std::move(llvmContext),
+                                            std::move(module),
+                                            "fake_hash",
+                                            "fake_path"));
+
+  FunctionHasher hasher;
+  hasher.computeHashes(context, 1);
+  std::string testHash = hasher.hashOf(test);
+
+  callback->front().getTerminator()->setOperand(
+    0, ConstantInt::get(Type::getInt32Ty(callback->getContext()), 2));
+
+  FunctionHasher changedHasher;
+  changedHasher.computeHashes(context, 1);
+  ASSERT_NE(testHash, changedHasher.hashOf(test));
+}
@@ -0,0 +1,109 @@
+#include "Context.h"
+#include "Filter.h"
+#include "FunctionStubs.h"
+#include "MutationOperators/MathAddMutationOperator.h"
+#include "MutationPoint.h"
+#include "MutationsFinder.h"
+#include "SymbolCache.h"
+#include "TestModuleFactory.h"
+#include "Testee.h"
+
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(FunctionStubs, addStub) {
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  MullModule &mullModule = *ModuleWithTestees.get();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("count_letters");
+
+  LLVMContext localContext;
+  auto clone = mullModule.clone(localContext);
+  Module *module = clone->getModule();
+  FunctionStubs::exposeLocalSymbols(*module, mullModule.getIdentifierHash());
+
+  Function *function = module->getFunction("count_letters");
+  ASSERT_TRUE(FunctionStubs::canStub(*function));
+
+  FunctionStubs stubs;
+  ASSERT_FALSE(stubs.hasStub(testeeFunction));
+  stubs.addStub(testeeFunction, function);
+  ASSERT_TRUE(stubs.hasStub(testeeFunction));
+  ASSERT_FALSE(verifyModule(*module, &errs()));
+
+  Function *stub = module->getFunction("count_letters");
+  Function *original = module->getFunction("count_letters.mull_original");
+  GlobalVariable *slot = module->getNamedGlobal("count_letters.mull_slot");
+  ASSERT_NE(nullptr, stub);
+  ASSERT_NE(nullptr, original);
+  ASSERT_NE(nullptr, slot);
+
+  ASSERT_TRUE(stub->hasExternalLinkage());
+  ASSERT_TRUE(original->hasInternalLinkage());
+
+  /// The slot is left to the mutant object, or to the empty slot
+  ASSERT_TRUE(slot->isDeclaration());
+  ASSERT_NE(0U, SymbolCache::getSymbolAddress("count_letters.mull_slot"));
+
+  BranchInst *dispatch =
+    dyn_cast<BranchInst>(stub->getEntryBlock().getTerminator());
+  ASSERT_NE(nullptr, dispatch);
+  ASSERT_TRUE(dispatch->isConditional());
+}
+
+TEST(FunctionStubs, extractMutant) {
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("count_letters");
+  Testee testee(testeeFunction, 0);
+
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints = finder.getMutationPoints(Ctx,
+                                                                         testee,
+                                                                         filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  MutationPoint *mutationPoint = mutationPoints.front();
+  MullModule *originalModule = mutationPoint->getOriginalModule();
+
+  LLVMContext localContext;
+  auto clone = originalModule->clone(localContext);
+  mutationPoint->applyMutation(*clone.get());
+  FunctionStubs::extractMutant(*clone.get(),
+                               testeeFunction,
+                               originalModule->getIdentifierHash());
+
+  Module *module = clone->getModule();
+  ASSERT_FALSE(verifyModule(*module, &errs()));
+
+  /// Only the mutant is left to compile
+  Function *mutant = module->getFunction("count_letters.mull_mutant");
+  ASSERT_NE(nullptr, mutant);
+  for (Function &function : *module) {
+    ASSERT_TRUE(&function == mutant || function.isDeclaration());
+  }
+
+  GlobalVariable *slot = module->getNamedGlobal("count_letters.mull_slot");
+  ASSERT_NE(nullptr, slot);
+  ASSERT_EQ(mutant, slot->getInitializer());
+}
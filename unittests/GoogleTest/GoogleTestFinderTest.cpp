@@ -90,6 +90,37 @@ mutation_operators:
   ASSERT_EQ("HelloTest.testSumOfTestee", Test1->getTestName());
 }
 
+TEST(GoogleTestFinder, indexTestBodies) {
+  auto ModuleWithTests = TestModuleFactory.create_GoogleTest_Tester_Module();
+
+  auto index = GoogleTestFinder::indexTestBodies(*ModuleWithTests->getModule());
+
+  ASSERT_EQ(2U, index.size());
+  ASSERT_EQ(1U, index.count("HelloTest_testSumOfTestee_Test"));
+  ASSERT_EQ(1U, index.count("HelloTest_testSumOfTestee2_Test"));
+  ASSERT_EQ("_ZN30HelloTest_testSumOfTestee_Test8TestBodyEv",
+            index["HelloTest_testSumOfTestee_Test"]->getName().str());
+}
+
+TEST(GoogleTestFinder, findTests_inParallel) {
+  Context Ctx;
+  Ctx.addModule(TestModuleFactory.create_GoogleTest_Tester_Module());
+  Ctx.addModule(TestModuleFactory.create_GoogleTest_Testee_Module());
+
+  Filter filter;
+  GoogleTestFinder Finder(4);
+
+  auto tests = Finder.findTests(Ctx, filter);
+
+  ASSERT_EQ(2U, tests.size());
+  ASSERT_EQ("HelloTest.testSumOfTestee", tests[0]->getTestName());
+  ASSERT_EQ("HelloTest.testSumOfTestee2", tests[1]->getTestName());
+
+  GoogleTest_Test *Test1 = dyn_cast<GoogleTest_Test>(tests[0].get());
+  GoogleTest_Test *Test2 = dyn_cast<GoogleTest_Test>(tests[1].get());
+  ASSERT_EQ(Test1->GetGlobalCtors().size(), Test2->GetGlobalCtors().size());
+}
+
 TEST(DISABLED_GoogleTestRunner, runTest) {
   const char *configYAML = R"YAML(
 mutation_operators:
@@ -26,3 +26,59 @@ TEST(ModuleLoaderTest, loadModuleFromBitcodeListFile) {
 
   ASSERT_EQ(modules.size(), 1U);
 }
+
+TEST(ModuleLoaderTest, loadModulesInParallel) {
+  llvm::LLVMContext context;
+
+  ModuleLoader loader(context, 4);
+
+  std::string bitcodeFile = testModuleFactory.testerModulePath_Bitcode();
+
+  std::vector<std::string> bitcodePaths = {
+    bitcodeFile, "missing.bc", bitcodeFile, bitcodeFile
+  };
+  std::vector<std::unique_ptr<MullModule>> modules =
+    loader.loadModulesFromBitcodeFileList(bitcodePaths);
+
+  ASSERT_EQ(modules.size(), 3U);
+
+  /// Each module is parsed into a context of its own
+  ASSERT_NE(&modules[0]->getModule()->getContext(), &context);
+  ASSERT_NE(&modules[0]->getModule()->getContext(),
+            &modules[1]->getModule()->getContext());
+
+  for (auto &module : modules) {
+    ASSERT_EQ(modules[0]->getUniqueIdentifier(), module->getUniqueIdentifier());
+  }
+}
+
+TEST(ModuleLoaderTest, loadModuleLazily) {
+  llvm::LLVMContext context;
+
+  ModuleLoader loader(context, 1, true);
+
+  std::string bitcodeFile = testModuleFactory.testerModulePath_Bitcode();
+
+  std::vector<std::string> bitcodePaths = { bitcodeFile };
+  std::vector<std::unique_ptr<MullModule>> modules =
+    loader.loadModulesFromBitcodeFileList(bitcodePaths);
+
+  ASSERT_EQ(modules.size(), 1U);
+
+  Function *function = nullptr;
+  for (Function &candidate : *modules[0]->getModule()) {
+    if (candidate.isMaterializable()) {
+      function = &candidate;
+      break;
+    }
+  }
+
+  ASSERT_NE(function, nullptr);
+  ASSERT_TRUE(function->empty());
+  ASSERT_FALSE(function->isDeclaration());
+
+  MullModule::materialize(function);
+
+  ASSERT_FALSE(function->isMaterializable());
+  ASSERT_FALSE(function->empty());
+}
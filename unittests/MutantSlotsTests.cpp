@@ -0,0 +1,85 @@
+#include "Context.h"
+#include "Filter.h"
+#include "MutantSlots.h"
+#include "MutationOperators/MathAddMutationOperator.h"
+#include "MutationPoint.h"
+#include "MutationsFinder.h"
+#include "TestModuleFactory.h"
+#include "Testee.h"
+
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(MutantSlots, addDispatcher) {
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("count_letters");
+  ASSERT_TRUE(MutantSlots::canDispatch(*testeeFunction));
+  Testee testee(testeeFunction, 0);
+
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints = finder.getMutationPoints(Ctx,
+                                                                         testee,
+                                                                         filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  LLVMContext localContext;
+  auto clone = mutationPoints.front()->getOriginalModule()->clone(localContext);
+
+  MutantSlots slots;
+  slots.addDispatcher(*clone.get(), testeeFunction, mutationPoints);
+
+  Module *module = clone->getModule();
+  ASSERT_FALSE(verifyModule(*module, &errs()));
+
+  Function *dispatcher = module->getFunction("count_letters");
+  Function *original = module->getFunction("count_letters.mull_original");
+  Function *mutant = module->getFunction("count_letters.mull_mutant_1");
+  ASSERT_NE(nullptr, dispatcher);
+  ASSERT_NE(nullptr, original);
+  ASSERT_NE(nullptr, mutant);
+
+  ASSERT_TRUE(original->hasInternalLinkage());
+  ASSERT_TRUE(mutant->hasInternalLinkage());
+
+  /// The original body is the default, the mutant is behind slot 1
+  SwitchInst *dispatch =
+    dyn_cast<SwitchInst>(dispatcher->getEntryBlock().getTerminator());
+  ASSERT_NE(nullptr, dispatch);
+  ASSERT_EQ(1U, dispatch->getNumCases());
+
+  /// The mutant subtracts where the original adds
+  unsigned originalAdds = 0;
+  unsigned mutantAdds = 0;
+  for (auto &block : *original) {
+    for (auto &instruction : block) {
+      if (instruction.getOpcode() == Instruction::Add) {
+        originalAdds++;
+      }
+    }
+  }
+  for (auto &block : *mutant) {
+    for (auto &instruction : block) {
+      if (instruction.getOpcode() == Instruction::Add) {
+        mutantAdds++;
+      }
+    }
+  }
+  ASSERT_EQ(originalAdds - 1, mutantAdds);
+}
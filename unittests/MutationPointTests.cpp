@@ -440,3 +440,42 @@ TEST(MutationPoint, SimpleTest_ReplaceAssignmentMutationOperator_applyMutation)
 
     ASSERT_TRUE(isa<StoreInst>(instructionByMutationAddress));
 }
+
+TEST(MutationPoint, SimpleTest_AddOperator_applyMutationAfterReleasingIR) {
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  MullModule *module = ModuleWithTestees.get();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("count_letters");
+  Testee testee(testeeFunction, 0);
+
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints = finder.getMutationPoints(Ctx,
+                                                                         testee,
+                                                                         filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  MutationPoint *MP = mutationPoints.front();
+  MutationPointAddress address = MP->getAddress();
+
+  module->releaseFunctionBodies();
+  ASSERT_TRUE(testeeFunction->isDeclaration());
+
+  /// The reporting data is copied when the point is found
+  ASSERT_EQ("count_letters", MP->getFunctionName());
+
+  LLVMContext localContext;
+  auto ownedMutatedModule = MP->getOriginalModule()->clone(localContext);
+  MP->applyMutation(*ownedMutatedModule.get());
+
+  llvm::Instruction &mutatedInstruction =
+    address.findInstruction(ownedMutatedModule->getModule());
+  ASSERT_TRUE(isa<BinaryOperator>(mutatedInstruction));
+  ASSERT_EQ(Instruction::Sub, mutatedInstruction.getOpcode());
+}
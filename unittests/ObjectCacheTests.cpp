@@ -0,0 +1,191 @@
+#include "Toolchain/Compiler.h"
+#include "Toolchain/ObjectCache.h"
+#include "MutationOperators/MathAddMutationOperator.h"
+#include "MutationPoint.h"
+#include "TestModuleFactory.h"
+
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::object;
+using namespace mull;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(ObjectCache, EvictsLeastRecentlyUsedMutants) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  Compiler compiler(*targetMachine.get());
+
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  uint64_t objectSize =
+    compiler.compileModule(*module).getBinary()->getData().size();
+
+  MathAddMutationOperator mutationOperator;
+  Value *value = &module->getModule()->getFunction("count_letters")->front().front();
+  MutationPoint first(&mutationOperator, MutationPointAddress(0, 0, 0),
+                      value, module.get());
+  MutationPoint second(&mutationOperator, MutationPointAddress(0, 0, 1),
+                       value, module.get());
+  MutationPoint third(&mutationOperator, MutationPointAddress(0, 0, 2),
+                      value, module.get());
+
+  /// Room for two mutants
+  ObjectCache cache(false, "", objectSize * 2);
+
+  cache.putObject(compiler.compileModule(*module), first,
+                  CodegenProfile::Default, false);
+  cache.putObject(compiler.compileModule(*module), second,
+                  CodegenProfile::Default, false);
+  ASSERT_EQ(objectSize * 2, cache.getMutantObjectsSize());
+
+  /// Using the first one makes the second one the least recently used
+  ASSERT_NE(nullptr, cache.getObject(first, CodegenProfile::Default, false));
+  cache.putObject(compiler.compileModule(*module), third,
+                  CodegenProfile::Default, false);
+
+  ASSERT_EQ(objectSize * 2, cache.getMutantObjectsSize());
+  ASSERT_NE(nullptr, cache.getObject(first, CodegenProfile::Default, false));
+  ASSERT_EQ(nullptr, cache.getObject(second, CodegenProfile::Default, false));
+  ASSERT_NE(nullptr, cache.getObject(third, CodegenProfile::Default, false));
+}
+
+TEST(ObjectCache, KeepsModuleObjects) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  Compiler compiler(*targetMachine.get());
+
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  MathAddMutationOperator mutationOperator;
+  Value *value = &module->getModule()->getFunction("count_letters")->front().front();
+  MutationPoint mutationPoint(&mutationOperator, MutationPointAddress(0, 0, 0),
+                              value, module.get());
+
+  /// Any mutant exceeds the budget
+  ObjectCache cache(false, "", 1);
+
+  cache.putObject(compiler.compileModule(*module), *module,
+                  CodegenProfile::Default, false);
+  cache.putObject(compiler.compileModule(*module), mutationPoint,
+                  CodegenProfile::Default, false);
+
+  ASSERT_NE(nullptr, cache.getObject(*module, CodegenProfile::Default, false));
+  ASSERT_NE(nullptr, cache.getObject(mutationPoint, CodegenProfile::Default, false));
+}
+
+TEST(ObjectCache, KeepsProfilesApart) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  Compiler compiler(*targetMachine.get());
+
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  MathAddMutationOperator mutationOperator;
+  Value *value = &module->getModule()->getFunction("count_letters")->front().front();
+  MutationPoint mutationPoint(&mutationOperator, MutationPointAddress(0, 0, 0),
+                              value, module.get());
+
+  ObjectCache cache(false, "", 0);
+
+  cache.putObject(compiler.compileModule(*module, CodegenProfile::Fast),
+                  *module, CodegenProfile::Fast, false);
+  cache.putObject(compiler.compileModule(*module, CodegenProfile::Fast),
+                  mutationPoint, CodegenProfile::Fast, false);
+
+  ASSERT_NE(nullptr, cache.getObject(*module, CodegenProfile::Fast, false));
+  ASSERT_NE(nullptr, cache.getObject(mutationPoint, CodegenProfile::Fast, false));
+  ASSERT_EQ(nullptr, cache.getObject(*module, CodegenProfile::Optimized, false));
+  ASSERT_EQ(nullptr, cache.getObject(mutationPoint, CodegenProfile::Default, false));
+}
+
+TEST(ObjectCache, KeepsObjectsCompiledOnDemandApart) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  Compiler compiler(*targetMachine.get());
+
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  MathAddMutationOperator mutationOperator;
+  Value *value = &module->getModule()->getFunction("count_letters")->front().front();
+  MutationPoint mutationPoint(&mutationOperator, MutationPointAddress(0, 0, 0),
+                              value, module.get());
+
+  ObjectCache cache(false, "", 0);
+
+  cache.putObject(compiler.compileModule(*module), *module,
+                  CodegenProfile::Default, true);
+  cache.putObject(compiler.compileModule(*module), mutationPoint,
+                  CodegenProfile::Default, true);
+
+  ASSERT_NE(nullptr, cache.getObject(*module, CodegenProfile::Default, true));
+  ASSERT_NE(nullptr, cache.getObject(mutationPoint, CodegenProfile::Default, true));
+  ASSERT_EQ(nullptr, cache.getObject(*module, CodegenProfile::Default, false));
+  ASSERT_EQ(nullptr, cache.getObject(mutationPoint, CodegenProfile::Default, false));
+}
+
+TEST(ObjectCache, AccountsDispatchObjectsAsMutants) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                  EngineBuilder().selectTarget(Triple(), "", "",
+                                  SmallVector<std::string, 1>()));
+  Compiler compiler(*targetMachine.get());
+
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+  uint64_t objectSize =
+    compiler.compileModule(*module).getBinary()->getData().size();
+
+  MathAddMutationOperator mutationOperator;
+  Value *value = &module->getModule()->getFunction("count_letters")->front().front();
+  MutationPoint first(&mutationOperator, MutationPointAddress(0, 0, 0),
+                      value, module.get());
+  MutationPoint second(&mutationOperator, MutationPointAddress(0, 0, 1),
+                       value, module.get());
+
+  std::vector<MutationPoint *> both({ &first, &second });
+  std::vector<MutationPoint *> secondOnly({ &second });
+
+  /// Room for one object
+  ObjectCache cache(false, "", objectSize);
+
+  cache.putDispatchObject(compiler.compileModule(*module), both,
+                          CodegenProfile::Default);
+  ASSERT_EQ(objectSize, cache.getMutantObjectsSize());
+  ASSERT_NE(nullptr, cache.getDispatchObject(both, CodegenProfile::Default));
+  ASSERT_EQ(nullptr, cache.getDispatchObject(secondOnly, CodegenProfile::Default));
+
+  /// A dispatch object of other mutants evicts it
+  cache.putDispatchObject(compiler.compileModule(*module), secondOnly,
+                          CodegenProfile::Default);
+  ASSERT_EQ(objectSize, cache.getMutantObjectsSize());
+  ASSERT_EQ(nullptr, cache.getDispatchObject(both, CodegenProfile::Default));
+  ASSERT_NE(nullptr, cache.getDispatchObject(secondOnly, CodegenProfile::Default));
+  ASSERT_EQ(nullptr, cache.getObject(second, CodegenProfile::Default, false));
+}
@@ -0,0 +1,91 @@
+#include "ProgressReporter.h"
+
+#include "gtest/gtest.h"
+
+#include <llvm/Support/raw_ostream.h>
+
+using namespace mull;
+using namespace llvm;
+
+TEST(ProgressReporter, estimatesRemainingTimeFromObservedCostOfEachTest) {
+  std::string output;
+  raw_string_ostream out(output);
+  ProgressReporter progress(ProgressReporter::Format::None, 10, out);
+
+  int fastTest = progress.addTest(10, 4);
+  int slowTest = progress.addTest(100, 2);
+  progress.start();
+
+  ASSERT_EQ(6, progress.plannedMutants());
+
+  /// Nothing observed yet: the baselines are the only estimate
+  ASSERT_EQ(4 * 10 + 2 * 100, progress.estimateRemainingMilliseconds());
+
+  progress.mutantFinished(fastTest, Failed, 30);
+  progress.mutantFinished(fastTest, Passed, 50);
+
+  /// The fast test costs 40ms per mutant, which is 4 times its baseline,
+  /// the slow one is expected to slow down as much
+  ASSERT_EQ(2 * 40 + 2 * 400, progress.estimateRemainingMilliseconds());
+
+  progress.mutantFinished(slowTest, Timedout, 150);
+
+  ASSERT_EQ(2 * 40 + 1 * 150, progress.estimateRemainingMilliseconds());
+  ASSERT_EQ(3, progress.finishedMutants());
+}
+
+TEST(ProgressReporter, skippedMutantsAreNotCostSamples) {
+  std::string output;
+  raw_string_ostream out(output);
+  ProgressReporter progress(ProgressReporter::Format::None, 10, out);
+  int test = progress.addTest(10, 4);
+  progress.start();
+
+  /// A reused result and an equivalent mutant take no time
+  progress.mutantFinished(test, Failed, 0, true);
+  progress.mutantFinished(test, Equivalent, 0, true);
+  progress.mutantFinished(test, Passed, 40);
+
+  ASSERT_EQ(3, progress.finishedMutants());
+  ASSERT_EQ(1 * 40, progress.estimateRemainingMilliseconds());
+}
+
+TEST(ProgressReporter, printsOnlyWhenAskedTo) {
+  std::string output;
+  raw_string_ostream out(output);
+  ProgressReporter progress(ProgressReporter::Format::None, 10, out);
+  progress.addTest(10, 1);
+  progress.start();
+  progress.mutantFinished(0, Passed, 10);
+  progress.finish();
+
+  ASSERT_TRUE(out.str().empty());
+}
+
+TEST(ProgressReporter, printsJSONLines) {
+  std::string output;
+  raw_string_ostream out(output);
+  ProgressReporter progress(ProgressReporter::Format::JSON, 10, out);
+  progress.addTest(10, 3);
+  progress.start();
+  progress.mutantFinished(0, Failed, 10);
+  progress.mutantFinished(0, Crashed, 10);
+  progress.mutantFinished(0, Passed, 10);
+  progress.finish();
+
+  std::string report = out.str();
+  ASSERT_EQ('{', report.front());
+  ASSERT_EQ("}\n", report.substr(report.size() - 2));
+  ASSERT_NE(std::string::npos, report.find("\"finished\":3,\"planned\":3"));
+  ASSERT_NE(std::string::npos, report.find("\"killed\":2,\"survived\":1"));
+  ASSERT_NE(std::string::npos, report.find("\"eta_ms\":0"));
+}
+
+TEST(ProgressReporter, parsesFormat) {
+  ASSERT_EQ(ProgressReporter::Format::Text,
+            ProgressReporter::formatFromString("text"));
+  ASSERT_EQ(ProgressReporter::Format::JSON,
+            ProgressReporter::formatFromString("json"));
+  ASSERT_EQ(ProgressReporter::Format::None,
+            ProgressReporter::formatFromString("none"));
+}
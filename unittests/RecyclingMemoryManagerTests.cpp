@@ -0,0 +1,58 @@
+#include "RecyclingMemoryManager.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+using namespace mull;
+using namespace llvm;
+
+TEST(RecyclingMemoryManager, reusesMemoryAfterReset) {
+  RecyclingMemoryManager memoryManager(1024 * 1024);
+
+  uint8_t *code = memoryManager.allocateCodeSection(100, 16, 0, ".text");
+  uint8_t *data = memoryManager.allocateDataSection(100, 64, 1, ".data", false);
+  ASSERT_NE(nullptr, code);
+  ASSERT_NE(nullptr, data);
+  ASSERT_NE(code, data);
+  ASSERT_EQ(0U, (uintptr_t)data % 64);
+
+  memset(data, 42, 100);
+  ASSERT_FALSE(memoryManager.finalizeMemory());
+  ASSERT_NE(0U, memoryManager.bytesInUse());
+
+  memoryManager.reset();
+  ASSERT_EQ(0U, memoryManager.bytesInUse());
+
+  /// Code pages are writable again after the reset
+  ASSERT_EQ(code, memoryManager.allocateCodeSection(100, 16, 0, ".text"));
+  memset(code, 0, 100);
+  ASSERT_EQ(data, memoryManager.allocateDataSection(100, 64, 1, ".data", false));
+}
+
+TEST(RecyclingMemoryManager, keepsFinalizedCodeApart) {
+  RecyclingMemoryManager memoryManager(1024 * 1024);
+
+  uint8_t *first = memoryManager.allocateCodeSection(100, 16, 0, ".text");
+  ASSERT_FALSE(memoryManager.finalizeMemory());
+
+  /// The next section must not land on the page that is executable now
+  uint8_t *second = memoryManager.allocateCodeSection(100, 16, 0, ".text");
+  ASSERT_NE(nullptr, second);
+  ASSERT_GE(second - first, 4096);
+  memset(second, 0, 100);
+  ASSERT_FALSE(memoryManager.finalizeMemory());
+}
+
+TEST(RecyclingMemoryManager, mapsSectionsThatDoNotFit) {
+  RecyclingMemoryManager memoryManager(64 * 1024);
+
+  uint8_t *data = memoryManager.allocateDataSection(1024 * 1024, 16, 0,
+                                                    ".data", false);
+  ASSERT_NE(nullptr, data);
+  memset(data, 0, 1024 * 1024);
+  ASSERT_EQ(1U, memoryManager.overflowMappings());
+
+  memoryManager.reset();
+  ASSERT_EQ(0U, memoryManager.overflowMappings());
+}
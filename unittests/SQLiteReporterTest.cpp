@@ -15,6 +15,7 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Type.h>
+#include <llvm/Support/FileSystem.h>
 #include <sqlite3.h>
 
 using namespace mull;
@@ -104,7 +105,7 @@ TEST(SQLiteReporter, integrationTest) {
   sqlite3 *database;
   sqlite3_open(databasePath.c_str(), &database);
 
-  std::string selectQuery = "SELECT * FROM execution_result";
+  std::string selectQuery = "SELECT status, duration, stdout, stderr FROM execution_result";
   sqlite3_stmt *selectStmt;
   sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
 
@@ -423,7 +424,10 @@ TEST(SQLiteReporter, do_emitDebugInfo) {
   sqlite3 *database;
   sqlite3_open(databasePath.c_str(), &database);
 
-  std::string selectQuery = "SELECT count(*) FROM mutation_point_debug";
+  /// The debug rows can still be joined by the unique id
+  std::string selectQuery = "SELECT count(*) FROM mutation_point_debug "
+    "JOIN mutation_point "
+    "ON mutation_point.unique_id = mutation_point_debug.unique_id";
   sqlite3_stmt *selectStmt;
   sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
 
@@ -601,3 +605,274 @@ TEST(SQLiteReporter, do_not_emitDebugInfo) {
   sqlite3_close(database);
 }
 
+
+TEST(SQLiteReporter, resume) {
+  TestModuleFactory testModuleFactory;
+
+  auto mullModuleWithTests   = testModuleFactory.create_SimpleTest_CountLettersTest_Module();
+  auto mullModuleWithTestees = testModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  Context context;
+  context.addModule(std::move(mullModuleWithTests));
+  context.addModule(std::move(mullModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder mutationsFinder(std::move(mutationOperators));
+  Filter filter;
+  SimpleTestFinder testFinder;
+  auto tests = testFinder.findTests(context, filter);
+
+  Function *testeeFunction = context.lookupDefinedFunction("count_letters");
+  Testee testee(testeeFunction, 1);
+
+  std::vector<MutationPoint *> mutationPoints =
+    mutationsFinder.getMutationPoints(context, testee, filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+  MutationPoint *mutationPoint = mutationPoints.front();
+
+  ExecutionResult testExecutionResult;
+  testExecutionResult.status = Passed;
+
+  ExecutionResult mutatedTestExecutionResult;
+  mutatedTestExecutionResult.status = Failed;
+
+  TestResult testResult(testExecutionResult, std::move(tests.front()));
+  MutationResult mutationResult(mutatedTestExecutionResult,
+                                mutationPoint,
+                                testee.getDistance());
+
+  Config config;
+  std::vector<std::string> bitcodeHashes({ "tester_hash", "testee_hash" });
+  ResultTime resultTime(1234, 5678);
+
+  /// The interrupted run only got as far as reporting the mutant
+  std::string databasePath;
+  {
+    SQLiteReporter reporter("resume test");
+    databasePath = reporter.getDatabasePath();
+    reporter.begin(config, bitcodeHashes);
+    ASSERT_FALSE(reporter.isReported(testResult, *mutationPoint));
+    reporter.reportTest(testResult);
+    reporter.reportMutant(testResult, mutationResult);
+  }
+
+  SQLiteReporter reporter;
+  reporter.resumeFrom(databasePath);
+  reporter.begin(config, bitcodeHashes);
+  ASSERT_TRUE(reporter.isReported(testResult, *mutationPoint));
+
+  /// Reporting the test again must not duplicate it
+  reporter.reportTest(testResult);
+  reporter.finish(config, resultTime);
+
+  sqlite3 *database;
+  sqlite3_open(databasePath.c_str(), &database);
+
+  std::string selectQuery = "SELECT COUNT(*) FROM test";
+  sqlite3_stmt *selectStmt;
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(1, sqlite3_column_int(selectStmt, 0));
+  sqlite3_finalize(selectStmt);
+
+  /// The mutant of count_letters was killed
+  selectQuery = "SELECT function_name, mutants, killed, score FROM function_score";
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(0, strcmp((const char *)sqlite3_column_text(selectStmt, 0), "count_letters"));
+  ASSERT_EQ(1, sqlite3_column_int(selectStmt, 1));
+  ASSERT_EQ(1, sqlite3_column_int(selectStmt, 2));
+  ASSERT_EQ(1.0, sqlite3_column_double(selectStmt, 3));
+  sqlite3_finalize(selectStmt);
+
+  /// The old layout is still available as a view
+  selectQuery = "SELECT test_id, mutation_point_id FROM mutation_result";
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(testResult.getDisplayName(),
+            std::string((const char *)sqlite3_column_text(selectStmt, 0)));
+  ASSERT_EQ(mutationPoint->getUniqueIdentifier(),
+            std::string((const char *)sqlite3_column_text(selectStmt, 1)));
+  sqlite3_finalize(selectStmt);
+
+  sqlite3_close(database);
+}
+
+TEST(SQLiteReporter, deduplicatesAndCompressesOutput) {
+  TestModuleFactory testModuleFactory;
+
+  auto mullModuleWithTests   = testModuleFactory.create_SimpleTest_CountLettersTest_Module();
+  auto mullModuleWithTestees = testModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  Context context;
+  context.addModule(std::move(mullModuleWithTests));
+  context.addModule(std::move(mullModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder mutationsFinder(std::move(mutationOperators));
+  Filter filter;
+  SimpleTestFinder testFinder;
+  auto tests = testFinder.findTests(context, filter);
+
+  Function *testeeFunction = context.lookupDefinedFunction("count_letters");
+  Testee testee(testeeFunction, 1);
+
+  std::vector<MutationPoint *> mutationPoints =
+    mutationsFinder.getMutationPoints(context, testee, filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  std::string banner(4096, '=');
+
+  ExecutionResult testExecutionResult;
+  testExecutionResult.status = Passed;
+  testExecutionResult.stdoutOutput = banner;
+  testExecutionResult.stderrOutput = "";
+
+  ExecutionResult mutatedTestExecutionResult;
+  mutatedTestExecutionResult.status = Failed;
+  mutatedTestExecutionResult.stdoutOutput = banner;
+  mutatedTestExecutionResult.stderrOutput = "";
+
+  TestResult testResult(testExecutionResult, std::move(tests.front()));
+  MutationResult mutationResult(mutatedTestExecutionResult,
+                                mutationPoints.front(),
+                                testee.getDistance());
+
+  SQLiteReporter reporter("output test");
+  std::string databasePath = reporter.getDatabasePath();
+  reporter.reportTest(testResult);
+  reporter.reportMutant(testResult, mutationResult);
+  reporter.finish(Config(), ResultTime(1234, 5678));
+
+  sqlite3 *database;
+  sqlite3_open(databasePath.c_str(), &database);
+
+  /// One blob for the banner and one for the empty stderr
+  std::string selectQuery = "SELECT size, compressed, length(data) FROM output_blob ORDER BY size DESC";
+  sqlite3_stmt *selectStmt;
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(4096, sqlite3_column_int(selectStmt, 0));
+  ASSERT_EQ(1, sqlite3_column_int(selectStmt, 1));
+  ASSERT_LT(sqlite3_column_int(selectStmt, 2), 4096);
+
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(0, sqlite3_column_int(selectStmt, 0));
+  ASSERT_EQ(0, sqlite3_column_int(selectStmt, 1));
+
+  ASSERT_EQ(SQLITE_DONE, sqlite3_step(selectStmt));
+  sqlite3_finalize(selectStmt);
+
+  /// The old layout joins the executions by rowid and reads without any
+  /// function defined, the compressed banner reads as NULL
+  selectQuery = "SELECT execution_result.stdout, execution_result.stderr "
+    "FROM mutation_result JOIN execution_result "
+    "ON execution_result.rowid = mutation_result.execution_result_id";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL));
+
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(SQLITE_NULL, sqlite3_column_type(selectStmt, 0));
+  ASSERT_EQ(std::string(""), std::string((const char *)sqlite3_column_text(selectStmt, 1)));
+  ASSERT_EQ(SQLITE_DONE, sqlite3_step(selectStmt));
+  sqlite3_finalize(selectStmt);
+
+  /// The full outputs need sqlar_uncompress
+  SQLiteReporter::registerFunctions(database);
+  selectQuery = "SELECT execution_output.stdout FROM mutation_result "
+    "JOIN execution_output "
+    "ON execution_output.execution_id = mutation_result.execution_result_id";
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(banner, std::string((const char *)sqlite3_column_text(selectStmt, 0)));
+  ASSERT_EQ(SQLITE_DONE, sqlite3_step(selectStmt));
+  sqlite3_finalize(selectStmt);
+
+  sqlite3_close(database);
+}
+
+static int countRows(sqlite3 *database, const std::string &table) {
+  std::string selectQuery = "SELECT COUNT(*) FROM " + table;
+  sqlite3_stmt *selectStmt;
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+  int count = sqlite3_step(selectStmt) == SQLITE_ROW ? sqlite3_column_int(selectStmt, 0) : -1;
+  sqlite3_finalize(selectStmt);
+  return count;
+}
+
+TEST(SQLiteReporter, mergeDatabases_isIdempotent) {
+  TestModuleFactory testModuleFactory;
+
+  auto mullModuleWithTests   = testModuleFactory.create_SimpleTest_CountLettersTest_Module();
+  auto mullModuleWithTestees = testModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  Context context;
+  context.addModule(std::move(mullModuleWithTests));
+  context.addModule(std::move(mullModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder mutationsFinder(std::move(mutationOperators));
+  Filter filter;
+  SimpleTestFinder testFinder;
+  auto tests = testFinder.findTests(context, filter);
+
+  Function *testeeFunction = context.lookupDefinedFunction("count_letters");
+  Testee testee(testeeFunction, 1);
+
+  std::vector<MutationPoint *> mutationPoints =
+    mutationsFinder.getMutationPoints(context, testee, filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  ExecutionResult testExecutionResult;
+  testExecutionResult.status = Passed;
+
+  ExecutionResult mutatedTestExecutionResult;
+  mutatedTestExecutionResult.status = Failed;
+
+  TestResult testResult(testExecutionResult, std::move(tests.front()));
+  MutationResult mutationResult(mutatedTestExecutionResult,
+                                mutationPoints.front(),
+                                testee.getDistance());
+
+  Config config;
+  std::vector<std::string> bitcodeHashes({ "tester_hash", "testee_hash" });
+
+  SQLiteReporter reporter("merge test");
+  std::string shardPath = reporter.getDatabasePath();
+  reporter.begin(config, bitcodeHashes);
+  reporter.reportTest(testResult);
+  reporter.reportMutant(testResult, mutationResult);
+  reporter.finish(config, ResultTime(1234, 5678));
+
+  std::string outputPath = shardPath + ".merged";
+  llvm::sys::fs::remove(outputPath);
+
+  /// Merging the same shard again, in one go and into the existing output,
+  /// must not add anything
+  SQLiteReporter::mergeDatabases(outputPath, { shardPath, shardPath });
+  SQLiteReporter::mergeDatabases(outputPath, { shardPath });
+
+  sqlite3 *database;
+  sqlite3_open(outputPath.c_str(), &database);
+
+  ASSERT_EQ(1, countRows(database, "run_info"));
+  ASSERT_EQ(1, countRows(database, "config"));
+  ASSERT_EQ(1, countRows(database, "test"));
+  ASSERT_EQ(1, countRows(database, "mutation_point"));
+  ASSERT_EQ(1, countRows(database, "mutation_execution"));
+  ASSERT_EQ(2, countRows(database, "execution"));
+
+  std::string selectQuery = "SELECT shard_index, shard_count FROM run_info";
+  sqlite3_stmt *selectStmt;
+  sqlite3_prepare(database, selectQuery.c_str(), selectQuery.size(), &selectStmt, NULL);
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(selectStmt));
+  ASSERT_EQ(0, sqlite3_column_int(selectStmt, 0));
+  ASSERT_EQ(1, sqlite3_column_int(selectStmt, 1));
+  sqlite3_finalize(selectStmt);
+
+  sqlite3_close(database);
+}
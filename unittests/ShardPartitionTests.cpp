@@ -0,0 +1,137 @@
+#include "Context.h"
+#include "MutationOperators/MathAddMutationOperator.h"
+#include "MutationOperators/NegateConditionMutationOperator.h"
+#include "MutationOperators/ScalarValueMutationOperator.h"
+#include "TestModuleFactory.h"
+#include "Testee.h"
+#include "MutationsFinder.h"
+#include "Filter.h"
+#include "ShardPartition.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(ShardPartition, shardsAreDisjointAndCoverAllMutants) {
+  Context Ctx;
+  Ctx.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
+  mutationOperators.emplace_back(make_unique<ScalarValueMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Testee testee(Ctx.lookupDefinedFunction("count_letters"), 1);
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints =
+    finder.getMutationPoints(Ctx, testee, filter);
+  ASSERT_LT(2U, mutationPoints.size());
+
+  const int shardCount = 2;
+  std::vector<std::unique_ptr<ShardPartition>> shards;
+  for (int shardIndex = 0; shardIndex < shardCount; shardIndex++) {
+    auto shard = make_unique<ShardPartition>(shardIndex, shardCount);
+    for (auto mutationPoint : mutationPoints) {
+      shard->addMutant(mutationPoint);
+    }
+    shard->partition();
+    shards.push_back(std::move(shard));
+  }
+
+  ASSERT_LT(0U, shards[0]->size());
+  ASSERT_LT(0U, shards[1]->size());
+
+  for (auto mutationPoint : mutationPoints) {
+    ASSERT_NE(shards[0]->contains(mutationPoint),
+              shards[1]->contains(mutationPoint));
+  }
+}
+
+TEST(ShardPartition, singleShardContainsEverything) {
+  Context Ctx;
+  Ctx.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Testee testee(Ctx.lookupDefinedFunction("count_letters"), 1);
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints =
+    finder.getMutationPoints(Ctx, testee, filter);
+
+  ShardPartition shard(0, 1);
+  ASSERT_FALSE(shard.isSharded());
+  ASSERT_TRUE(shard.contains(mutationPoints.front()));
+}
+
+/// Each shard runs in its own process: it loads the modules on its own, finds
+/// the mutants in its own order and times the baseline on its own. None of
+/// it may change the partition.
+TEST(ShardPartition, shardsAgreeDespiteDifferentTimings) {
+  const int shardCount = 3;
+  /// Baseline running times of the two tests as each shard measured them
+  const std::vector<std::vector<long long>> timings = {
+    { 100, 7 }, { 101, 6 }, { 99, 8 }
+  };
+
+  std::map<std::string, int> owners;
+  size_t mutantsCount = 0;
+
+  for (int shardIndex = 0; shardIndex < shardCount; shardIndex++) {
+    Context Ctx;
+    Ctx.addModule(TestModuleFactory.create_SimpleTest_CountLetters_Module());
+
+    std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+    mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+    mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
+    mutationOperators.emplace_back(make_unique<ScalarValueMutationOperator>());
+    MutationsFinder finder(std::move(mutationOperators));
+
+    Testee testee(Ctx.lookupDefinedFunction("count_letters"), 1);
+    Filter filter;
+    std::vector<MutationPoint *> mutationPoints =
+      finder.getMutationPoints(Ctx, testee, filter);
+    ASSERT_LT(2U, mutationPoints.size());
+    mutantsCount = mutationPoints.size();
+
+    /// The first test reaches every mutant, the second one every other one
+    std::vector<std::vector<MutationPoint *>> reachedMutants(2);
+    for (size_t index = 0; index < mutationPoints.size(); index++) {
+      reachedMutants[0].push_back(mutationPoints[index]);
+      if (index % 2 == 0) {
+        reachedMutants[1].push_back(mutationPoints[index]);
+      }
+    }
+
+    if (shardIndex % 2) {
+      std::reverse(reachedMutants.begin(), reachedMutants.end());
+      std::reverse(reachedMutants[0].begin(), reachedMutants[0].end());
+    }
+
+    ShardPartition shard(shardIndex, shardCount);
+    for (size_t test = 0; test < timings[shardIndex].size(); test++) {
+      for (auto mutationPoint : reachedMutants[test]) {
+        shard.addMutant(mutationPoint);
+      }
+    }
+    shard.partition();
+
+    for (auto mutationPoint : mutationPoints) {
+      if (shard.contains(mutationPoint)) {
+        owners[mutationPoint->getUniqueIdentifier()]++;
+      }
+    }
+  }
+
+  ASSERT_EQ(mutantsCount, owners.size());
+  for (auto &owner : owners) {
+    ASSERT_EQ(1, owner.second);
+  }
+}
@@ -0,0 +1,54 @@
+#include "SymbolCache.h"
+
+#include "gtest/gtest.h"
+
+#include <llvm/Support/DynamicLibrary.h>
+
+using namespace mull;
+using namespace llvm;
+
+/// The cache is global, other tests of the binary fill it as well
+class SymbolCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    SymbolCache::clear();
+  }
+};
+
+TEST_F(SymbolCacheTest, cachesOnlyFoundSymbols) {
+  sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+  SymbolCache::prefetch({}, {});
+
+  ASSERT_NE(0U, SymbolCache::getSymbolAddress("malloc"));
+  ASSERT_EQ(1U, SymbolCache::size());
+
+  /// Same address on the second lookup, served from the cache
+  ASSERT_EQ(SymbolCache::getSymbolAddress("malloc"),
+            SymbolCache::getSymbolAddress("malloc"));
+  ASSERT_EQ(1U, SymbolCache::size());
+
+  ASSERT_EQ(0U, SymbolCache::getSymbolAddress("mull_missing_symbol"));
+  ASSERT_EQ(1U, SymbolCache::size());
+}
+
+TEST_F(SymbolCacheTest, dropsCacheWhenDynamicLibrariesChange) {
+  sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+  SymbolCache::prefetch({}, {});
+  SymbolCache::getSymbolAddress("malloc");
+  ASSERT_EQ(1U, SymbolCache::size());
+
+  SymbolCache::prefetch({}, {});
+  ASSERT_EQ(1U, SymbolCache::size());
+
+  SymbolCache::prefetch({}, { "libfoo.so" });
+  ASSERT_EQ(0U, SymbolCache::size());
+}
+
+TEST_F(SymbolCacheTest, definedSymbolsSurviveLibraryChanges) {
+  uint64_t slot = 0;
+  SymbolCache::define("mull_defined_symbol", (uint64_t)&slot);
+  ASSERT_EQ((uint64_t)&slot, SymbolCache::getSymbolAddress("mull_defined_symbol"));
+
+  SymbolCache::prefetch({}, { "libbar.so" });
+  ASSERT_EQ((uint64_t)&slot, SymbolCache::getSymbolAddress("mull_defined_symbol"));
+}
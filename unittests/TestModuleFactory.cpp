@@ -201,6 +201,21 @@ std::unique_ptr<MullModule> TestModuleFactory::create_SimpleTest_CountLetters_Mo
   return createModuleFromBitcode("simple_test/count_letters/count_letters.bc", "count_letters");
 }
 
+std::unique_ptr<MullModule> TestModuleFactory::create_SimpleTest_EquivalentMutants_Module() {
+  const char *fixture = "simple_test/equivalent_mutants/equivalent_mutants.bc";
+  return createModuleFromBitcode(fixture, fixture);
+}
+
+std::unique_ptr<MullModule> TestModuleFactory::create_SimpleTest_StaticTesteeTest_Module() {
+  const char *fixture = "simple_test/static_testee/test_static_testee.bc";
+  return createModuleFromBitcode(fixture, fixture);
+}
+
+std::unique_ptr<MullModule> TestModuleFactory::create_SimpleTest_StaticTestee_Module() {
+  const char *fixture = "simple_test/static_testee/static_testee.bc";
+  return createModuleFromBitcode(fixture, fixture);
+}
+
 #pragma mark - Google Test
 
 std::unique_ptr<MullModule> TestModuleFactory::create_GoogleTest_Tester_Module() {
@@ -19,6 +19,9 @@ public:
   
   std::unique_ptr<MullModule> create_SimpleTest_CountLettersTest_Module();
   std::unique_ptr<MullModule> create_SimpleTest_CountLetters_Module();
+  std::unique_ptr<MullModule> create_SimpleTest_EquivalentMutants_Module();
+  std::unique_ptr<MullModule> create_SimpleTest_StaticTesteeTest_Module();
+  std::unique_ptr<MullModule> create_SimpleTest_StaticTestee_Module();
 
   std::unique_ptr<MullModule> create_SimpleTest_MathSub_Module();
   std::unique_ptr<MullModule> create_SimpleTest_MathMul_Module();
@@ -0,0 +1,126 @@
+#include "Context.h"
+#include "MutationOperators/MathAddMutationOperator.h"
+#include "MutationOperators/MathMulMutationOperator.h"
+#include "MutationOperators/RemoveVoidFunctionMutationOperator.h"
+#include "TestModuleFactory.h"
+#include "Testee.h"
+#include "MutationsFinder.h"
+#include "Filter.h"
+#include "TrivialCompilerEquivalence.h"
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "gtest/gtest.h"
+
+using namespace mull;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+TEST(TrivialCompilerEquivalence, hashOptimizedFunction_isStableAcrossClones) {
+  auto module = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  LLVMContext firstContext;
+  auto firstClone = module->clone(firstContext);
+  LLVMContext secondContext;
+  auto secondClone = module->clone(secondContext);
+
+  Function *first = firstClone->getModule()->getFunction("count_letters");
+  Function *second = secondClone->getModule()->getFunction("count_letters");
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+
+  ASSERT_EQ(TrivialCompilerEquivalence::hashOptimizedFunction(*first),
+            TrivialCompilerEquivalence::hashOptimizedFunction(*second));
+}
+
+TEST(TrivialCompilerEquivalence, MathAddMutantIsNotEquivalent) {
+  auto ModuleWithTests   = TestModuleFactory.create_SimpleTest_CountLettersTest_Module();
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_CountLetters_Module();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTests));
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathAddMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("count_letters");
+  Testee testee(testeeFunction, 0);
+
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints = finder.getMutationPoints(Ctx,
+                                                                         testee,
+                                                                         filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  TrivialCompilerEquivalence tce;
+  tce.analyzeFunction(mutationPoints);
+
+  ASSERT_FALSE(tce.isEquivalent(mutationPoints.front()));
+  ASSERT_EQ(nullptr, tce.aliasOf(mutationPoints.front()));
+  ASSERT_EQ(0U, tce.equivalentMutantsCount());
+  ASSERT_EQ(0U, tce.aliasesCount());
+}
+
+TEST(TrivialCompilerEquivalence, MutantOptimizedToOriginalIsEquivalent) {
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_EquivalentMutants_Module();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<MathMulMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("scale_by_one");
+  Testee testee(testeeFunction, 0);
+
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints = finder.getMutationPoints(Ctx,
+                                                                         testee,
+                                                                         filter);
+  ASSERT_EQ(1U, mutationPoints.size());
+
+  TrivialCompilerEquivalence tce;
+  tce.analyzeFunction(mutationPoints);
+
+  ASSERT_TRUE(tce.isEquivalent(mutationPoints.front()));
+  ASSERT_EQ(nullptr, tce.aliasOf(mutationPoints.front()));
+  ASSERT_EQ(1U, tce.equivalentMutantsCount());
+  ASSERT_EQ(0U, tce.aliasesCount());
+}
+
+TEST(TrivialCompilerEquivalence, MutantsWithTheSameCodeAreAliases) {
+  auto ModuleWithTestees = TestModuleFactory.create_SimpleTest_EquivalentMutants_Module();
+
+  Context Ctx;
+  Ctx.addModule(std::move(ModuleWithTestees));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<RemoveVoidFunctionMutationOperator>());
+  MutationsFinder finder(std::move(mutationOperators));
+
+  Function *testeeFunction = Ctx.lookupDefinedFunction("log_twice");
+  Testee testee(testeeFunction, 0);
+
+  Filter filter;
+  std::vector<MutationPoint *> mutationPoints = finder.getMutationPoints(Ctx,
+                                                                         testee,
+                                                                         filter);
+  ASSERT_EQ(2U, mutationPoints.size());
+
+  TrivialCompilerEquivalence tce;
+  tce.analyzeFunction(mutationPoints);
+
+  /// Either call removed leaves a single call, the second mutant is an
+  /// alias of the first one
+  ASSERT_FALSE(tce.isEquivalent(mutationPoints[0]));
+  ASSERT_FALSE(tce.isEquivalent(mutationPoints[1]));
+  ASSERT_EQ(nullptr, tce.aliasOf(mutationPoints[0]));
+  ASSERT_EQ(mutationPoints[0], tce.aliasOf(mutationPoints[1]));
+  ASSERT_EQ(0U, tce.equivalentMutantsCount());
+  ASSERT_EQ(1U, tce.aliasesCount());
+}
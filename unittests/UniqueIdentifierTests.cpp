@@ -19,8 +19,8 @@ TEST(MullModule, uniqueIdentifier) {
   auto module = loader.loadModuleAtPath(testModuleFactory.testerModulePath_Bitcode());
 
   string moduleName = "fixture_simple_test_tester_module";
-  string moduleMD5  = "de5070f8606cc2a8ee794b2ab56b31f2";
-  string uniqueID   = moduleName + "_" + moduleMD5;
+  string moduleHash = "24a0043f0197d14c";
+  string uniqueID   = moduleName + "_" + moduleHash;
 
   ASSERT_EQ(module->getUniqueIdentifier(), uniqueID);
 }
@@ -36,14 +36,30 @@ TEST(MutationPoint, uniqueIdentifier) {
   MutationPoint point(&mutationOperator, address, nullptr, module.get());
 
   string moduleName = "fixture_simple_test_tester_module";
-  string moduleMD5  = "de5070f8606cc2a8ee794b2ab56b31f2";
+  string moduleHash = "24a0043f0197d14c";
   string addressString = "2_3_5";
   string operatorName = "math_add_mutation_operator";
 
   string uniqueID = moduleName + "_"
-      + moduleMD5 + "_"
+      + moduleHash + "_"
       + addressString + "_"
       + operatorName;
 
   ASSERT_EQ(point.getUniqueIdentifier(), uniqueID);
 }
+
+TEST(MutationPoint, identifierHash) {
+  LLVMContext context;
+  ModuleLoader loader(context);
+  auto module = loader.loadModuleAtPath(testModuleFactory.testerModulePath_Bitcode());
+
+  MathAddMutationOperator mutationOperator;
+
+  MutationPoint point(&mutationOperator, MutationPointAddress(2, 3, 5), nullptr, module.get());
+  MutationPoint samePoint(&mutationOperator, MutationPointAddress(2, 3, 5), nullptr, module.get());
+  MutationPoint otherPoint(&mutationOperator, MutationPointAddress(2, 5, 3), nullptr, module.get());
+
+  ASSERT_EQ(point.getIdentifierHash(), samePoint.getIdentifierHash());
+  ASSERT_NE(point.getIdentifierHash(), otherPoint.getIdentifierHash());
+  ASSERT_NE(point.getIdentifierHash(), module->getIdentifierHash());
+}